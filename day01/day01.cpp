@@ -1,87 +1,99 @@
+#include "day01.h"
+
+#include "incremental.h"
+#include "mappedinput.h"
+#include "parallel.h"
+#include "probes.h"
+
 #include <QDebug>
-#include <QFile>
-#include <QHash>
-#include <QMap>
 #include <QString>
+#include <QVector>
+
+#include <string_view>
+#include <utility>
+
+namespace Day01 {
 
-namespace {
+using Numbers = QVector<std::pair<std::string_view, quint32>>;
 
-QString sum(const QString &fileName, const QHash<QString, QString> &numbersMap)
+quint32 calibrationValue(std::string_view line, const Numbers &numbers)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
-        return {};
+    auto first = std::pair{std::string_view::npos, 0u};
+    auto last  = std::pair{std::string_view::npos, 0u};
+
+    for (const auto &[name, value] : numbers) {
+        if (const auto index = line.find(name); index < first.first)
+            first = {index, value};
+        if (const auto index = line.rfind(name); index != std::string_view::npos
+                                                 && (last.first == std::string_view::npos || index > last.first))
+            last = {index, value};
     }
 
-    quint32 sum = 0;
-    while (!file.atEnd()) {
-        const QString      line = file.readLine();
-        QMap<int, QString> searchResults;
+    return first.second * 10 + last.second;
+}
+
+// stateName identifies the incremental state, each part has its own
+QString sum(const QString &fileName, const char *stateName, const Numbers &numbers)
+{
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
 
-        for (QHashIterator i(numbersMap); i.hasNext();) {
-            i.next();
-            int index = line.indexOf(i.key());
-            while (index != -1) {
-                searchResults.insert(index, i.key());
-                index = line.indexOf(i.key(), index + 1);
-            }
-        }
-        sum += (numbersMap.value(searchResults.first()) + numbersMap.value(searchResults.last())).toUInt();
-    }
+    // lines are parsed and summed in one pass, in parallel; incrementally only
+    // the lines appended since the last run
+    probe.next("solve");
+    const auto sum = utils::incrementalReduce<quint32>(
+        stateName, 1, fileName, input.data(), [&numbers](quint32 &total, std::string_view lines) {
+            total += utils::parallelLinesReduce<quint32>(
+                lines, [&numbers](std::string_view line) { return calibrationValue(line, numbers); });
+        });
 
     return QString::number(sum);
 }
 
 QString part1(const QString &inputFile)
 {
-    return sum(inputFile,
+    return sum(inputFile, "day01-part1",
                {
-                   {"0", "0"},
-                   {"1", "1"},
-                   {"2", "2"},
-                   {"3", "3"},
-                   {"4", "4"},
-                   {"5", "5"},
-                   {"6", "6"},
-                   {"7", "7"},
-                   {"8", "8"},
-                   {"9", "9"},
+                   {"0", 0},
+                   {"1", 1},
+                   {"2", 2},
+                   {"3", 3},
+                   {"4", 4},
+                   {"5", 5},
+                   {"6", 6},
+                   {"7", 7},
+                   {"8", 8},
+                   {"9", 9},
     });
 }
 
 QString part2(const QString &inputFile)
 {
-    return sum(inputFile,
+    return sum(inputFile, "day01-part2",
                {
-                   {"zero",  "0"},
-                   {"one",   "1"},
-                   {"two",   "2"},
-                   {"three", "3"},
-                   {"four",  "4"},
-                   {"five",  "5"},
-                   {"six",   "6"},
-                   {"seven", "7"},
-                   {"eight", "8"},
-                   {"nine",  "9"},
-                   {"0",     "0"},
-                   {"1",     "1"},
-                   {"2",     "2"},
-                   {"3",     "3"},
-                   {"4",     "4"},
-                   {"5",     "5"},
-                   {"6",     "6"},
-                   {"7",     "7"},
-                   {"8",     "8"},
-                   {"9",     "9"},
+                   {"zero",  0},
+                   {"one",   1},
+                   {"two",   2},
+                   {"three", 3},
+                   {"four",  4},
+                   {"five",  5},
+                   {"six",   6},
+                   {"seven", 7},
+                   {"eight", 8},
+                   {"nine",  9},
+                   {"0",     0},
+                   {"1",     1},
+                   {"2",     2},
+                   {"3",     3},
+                   {"4",     4},
+                   {"5",     5},
+                   {"6",     6},
+                   {"7",     7},
+                   {"8",     8},
+                   {"9",     9},
     });
 }
 
-} // namespace
-
-int main(int argc, char *argv[])
-{
-    qInfo() << "Part 1:" << part1(":/input.txt");
-    qInfo() << "Part 2:" << part2(":/input.txt");
-    return 0;
-}
+} // namespace Day01
@@ -0,0 +1,8 @@
+#include "day01.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day01::part1, Day01::part2);
+}
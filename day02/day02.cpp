@@ -1,8 +1,19 @@
+#include "day02.h"
+
+#include "incremental.h"
+#include "mappedinput.h"
+#include "parallel.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QMetaEnum>
 #include <QString>
-#include <QVariant>
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
 
 namespace Day02 {
 
@@ -11,52 +22,76 @@ Q_NAMESPACE
 enum class Color { red, green, blue };
 Q_ENUM_NS(Color)
 
-QMap<Color, int> maxScoresFromGame(const QString &game)
+struct Scores
 {
-    QMap<Color, int> scores;
-    for (const auto &set : game.split(";")) {
-        for (const auto &element : set.split(",")) {
-            const auto sep   = element.trimmed().split(" ");
-            const auto score = sep[0].toInt();
-            const auto color = QVariant::fromValue(sep[1]).value<Color>();
-            scores[color]    = qMax(scores[color], score);
+    std::array<int, 3> values{};
+
+    int &operator[](Color color) { return values[static_cast<std::size_t>(color)]; }
+
+    int operator[](Color color) const { return values[static_cast<std::size_t>(color)]; }
+};
+
+std::optional<Color> colorFromName(std::string_view name)
+{
+    // color names fit into the small string buffer, so this does not allocate
+    const std::string key(name);
+    bool              ok    = false;
+    const auto        value = QMetaEnum::fromType<Color>().keyToValue(key.c_str(), &ok);
+    return ok ? std::optional(static_cast<Color>(value)) : std::nullopt;
+}
+
+Scores maxScoresFromGame(std::string_view game)
+{
+    Scores scores;
+    for (const auto set : utils::split(game, ';')) {
+        for (const auto element : utils::split(set, ',')) {
+            const auto [score, name] = utils::splitFixed<2>(utils::trimmed(element), ' ');
+            if (const auto color = colorFromName(name))
+                scores[*color] = qMax(scores[*color], utils::toNumber<int>(score));
         }
     }
     return scores;
 }
 
+// stateName identifies the incremental state, each part has its own
 template<typename Fn>
-QString process(Fn function, const QString &fileName)
+QString process(const char *stateName, Fn function, const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return {};
-    }
 
-    quint32 sum = 0;
+    const auto score = [&function](std::string_view line) {
+        const auto posOfGameSep = line.find(": ");
+        if (posOfGameSep == std::string_view::npos)
+            return 0u;
+        const auto gameId = utils::toNumber<int>(line.substr(0, posOfGameSep).substr(std::string_view("Game ").size()));
+        const auto game   = line.substr(posOfGameSep + 2);
+        return static_cast<quint32>(function(gameId, game));
+    };
 
-    while (!file.atEnd()) {
-        const QString line         = file.readLine();
-        const auto    posOfGameSep = line.indexOf(": ");
-        const auto    gameId       = line.left(posOfGameSep).replace("Game ", "").toInt();
-        const auto    game         = line.mid(posOfGameSep + 2);
-        sum += function(gameId, game);
-    }
+    // games are parsed and scored in one pass, in parallel; incrementally only
+    // the games appended since the last run
+    probe.next("solve");
+    const auto sum = utils::incrementalReduce<quint32>(
+        stateName, 1, fileName, input.data(), [&score](quint32 &total, std::string_view lines) {
+            total += utils::parallelLinesReduce<quint32>(lines, score);
+        });
 
     return QString::number(sum);
 }
 
 QString part1(const QString &fileName)
 {
-    const QMap<Color, int> maxScores{
-        {Color::red,   12},
-        {Color::green, 13},
-        {Color::blue,  14}
-    };
+    Scores maxScores;
+    maxScores[Color::red]   = 12;
+    maxScores[Color::green] = 13;
+    maxScores[Color::blue]  = 14;
 
     return process(
-        [&maxScores](const int gameId, const QString &game) {
+        "day02-part1",
+        [&maxScores](const int gameId, std::string_view game) {
             if (const auto scores = maxScoresFromGame(game);
                 scores[Color::red] <= maxScores[Color::red] && scores[Color::green] <= maxScores[Color::green]
                 && scores[Color::blue] <= maxScores[Color::blue]) {
@@ -70,7 +105,8 @@ QString part1(const QString &fileName)
 QString part2(const QString &fileName)
 {
     return process(
-        [](const int, const QString &game) {
+        "day02-part2",
+        [](const int, std::string_view game) {
             const auto scores = maxScoresFromGame(game);
             return scores[Color::red] * scores[Color::green] * scores[Color::blue];
         },
@@ -79,11 +115,4 @@ QString part2(const QString &fileName)
 
 } // namespace Day02
 
-int main()
-{
-    qInfo() << "Part 1:" << Day02::part1(":/input.txt");
-    qInfo() << "Part 2:" << Day02::part2(":/input.txt");
-    return 0;
-}
-
 #include "day02.moc"
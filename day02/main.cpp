@@ -0,0 +1,8 @@
+#include "day02.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day02::part1, Day02::part2);
+}
@@ -1,7 +1,16 @@
+#include "day03.h"
+
+#include "arena.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
-#include <QVector>
+
+#include <algorithm>
+#include <span>
+#include <string_view>
 
 namespace Day03 {
 
@@ -12,27 +21,32 @@ bool isInRange(const int x1, const int length, const int x2)
 
 enum class Type { None, Number, Symbol, Asterisk };
 
+struct Part;
+
+using Row  = utils::ArenaVector<Part>;
+using Rows = utils::ArenaVector<Row>;
+
 struct Part
 {
-    Type    type = Type::None;
-    QString value;
-    int     pos = 0;
+    Type             type = Type::None;
+    std::string_view value; // view into the input, valid as long as it is mapped
+    int              pos = 0;
 
     void clear()
     {
-        type = Type::None;
-        value.clear();
-        pos = 0;
+        type  = Type::None;
+        value = {};
+        pos   = 0;
     }
 
-    [[nodiscard]] QVector<Part> adjacents(const Type adjType, const QVector<QVector<Part>> &parts) const
+    [[nodiscard]] Row adjacents(const Type adjType, std::span<const Row> rows, utils::ArenaAllocator allocator) const
     {
-        QVector<Part> result;
-        for (auto &row : parts) {
+        Row result(allocator);
+        for (auto &row : rows) {
             for (auto &part : row) {
                 if (part.type == adjType
                     && (isInRange(pos, value.length(), part.pos) || isInRange(part.pos, part.value.length(), pos))) {
-                    result.append(part);
+                    result.push_back(part);
                 }
             }
         }
@@ -40,65 +54,67 @@ struct Part
     }
 };
 
-QVector<Part> parseLine(const QString &line, bool isPart2 = false)
+// the given row and the rows directly above and below it
+std::span<const Row> neighbourhood(const Rows &rows, qsizetype row)
+{
+    const auto first = std::max<qsizetype>(row - 1, 0);
+    const auto last  = std::min<qsizetype>(row + 1, std::ssize(rows) - 1);
+    return std::span(rows).subspan(first, last - first + 1);
+}
+
+Row parseLine(std::string_view line, bool isPart2, utils::ArenaAllocator allocator)
 {
-    QVector<Part> parts;
-    Part          part;
-    int           pos = 0;
+    Row  parts(allocator);
+    Part part;
+    int  pos = 0;
     for (const auto &c : line) {
-        if (c.isDigit()) {
+        if (c >= '0' && c <= '9') {
             if (part.type == Type::None)
                 part.pos = pos;
-            part.type = Type::Number;
-            part.value += c;
+            part.type  = Type::Number;
+            part.value = line.substr(part.pos, pos - part.pos + 1);
         } else {
             if (part.type != Type::None) {
-                parts.append(part);
+                parts.push_back(part);
                 part.clear();
             }
 
             if (isPart2 && c == '*')
-                parts.append({.type = Type::Asterisk, .value = c, .pos = pos});
+                parts.push_back({.type = Type::Asterisk, .value = line.substr(pos, 1), .pos = pos});
             else if (c != '.')
-                parts.append({.type = Type::Symbol, .value = c, .pos = pos});
+                parts.push_back({.type = Type::Symbol, .value = line.substr(pos, 1), .pos = pos});
         }
         pos++;
     }
 
     if (part.type != Type::None)
-        parts.append(part);
+        parts.push_back(part);
 
     return parts;
 }
 
 QString part1(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return {};
-    }
 
-    QVector<QVector<Part>> parts;
-    while (!file.atEnd()) {
-        const QString line = file.readLine();
-        parts.append(parseLine(line.trimmed(), false));
-    }
+    // all rows and the adjacency results are freed with the arena
+    utils::Arena arena(input.size() * 4);
+    Rows         parts(arena.allocator());
+    for (const auto line : input.lines())
+        parts.push_back(parseLine(utils::trimmed(line), false, arena.allocator()));
 
+    probe.next("solve");
     int sum = 0;
 
-    for (int row = 0; row < parts.size(); row++) {
+    for (qsizetype row = 0; row < std::ssize(parts); row++) {
         for (auto const &part : parts[row]) {
             if (part.type == Type::Number) {
-                QVector<QVector<Part>> adjacentRows;
-                if (row > 0)
-                    adjacentRows.append(parts[row - 1]);
-                if (row < parts.size() - 1)
-                    adjacentRows.append(parts[row + 1]);
-                adjacentRows.append(parts[row]);
-
-                if (!part.adjacents(Type::Symbol, adjacentRows).empty())
-                    sum += part.value.toInt();
+                const auto adjacentRows = neighbourhood(parts, row);
+                if (!part.adjacents(Type::Symbol, adjacentRows, arena.allocator()).empty())
+                    sum += utils::toNumber<int>(part.value);
             }
         }
     }
@@ -108,31 +124,25 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return {};
-    }
 
-    QVector<QVector<Part>> parts;
-    while (!file.atEnd()) {
-        const QString line = file.readLine();
-        parts.append(parseLine(line.trimmed(), true));
-    }
+    // all rows and the adjacency results are freed with the arena
+    utils::Arena arena(input.size() * 4);
+    Rows         parts(arena.allocator());
+    for (const auto line : input.lines())
+        parts.push_back(parseLine(utils::trimmed(line), true, arena.allocator()));
 
+    probe.next("solve");
     int sum = 0;
-    for (int row = 0; row < parts.size(); row++) {
+    for (qsizetype row = 0; row < std::ssize(parts); row++) {
         for (auto const &part : parts[row]) {
             if (part.type == Type::Asterisk) {
-                QVector<QVector<Part>> adjacentRows;
-                if (row > 0)
-                    adjacentRows.append(parts[row - 1]);
-                if (row < parts.size() - 1)
-                    adjacentRows.append(parts[row + 1]);
-                adjacentRows.append(parts[row]);
-
-                if (auto adjacentParts = part.adjacents(Type::Number, adjacentRows); adjacentParts.size() == 2) {
-                    sum += adjacentParts[0].value.toInt() * adjacentParts[1].value.toInt();
+                const auto adjacentRows = neighbourhood(parts, row);
+                if (auto adjacentParts = part.adjacents(Type::Number, adjacentRows, arena.allocator()); adjacentParts.size() == 2) {
+                    sum += utils::toNumber<int>(adjacentParts[0].value) * utils::toNumber<int>(adjacentParts[1].value);
                 }
             }
         }
@@ -141,10 +151,3 @@ QString part2(const QString &fileName)
 }
 
 } // namespace Day03
-
-int main()
-{
-    qInfo() << "Part 1:" << Day03::part1(":/input.txt");
-    qInfo() << "Part 2:" << Day03::part2(":/input.txt");
-    return 0;
-}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <QString>
+
+namespace Day03 {
+
+QString part1(const QString &fileName);
+QString part2(const QString &fileName);
+
+} // namespace Day03
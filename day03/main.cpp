@@ -0,0 +1,8 @@
+#include "day03.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day03::part1, Day03::part2);
+}
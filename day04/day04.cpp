@@ -1,80 +1,143 @@
+#include "day04.h"
+
+#include "incremental.h"
+#include "mappedinput.h"
+#include "parallel.h"
+#include "numbers.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
-#include <QVector>
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace Day04 {
 
-QVector<int> intersect(const QVector<int> &a, const QVector<int> &b)
-{
-    QVector<int> result;
-    for (const int &e : a) {
-        if (b.contains(e))
-            result.append(e);
-    }
-    return result;
-}
+// more numbers per side than the cards usually have, so that they are scanned
+// without allocating
+constexpr std::size_t maxNumbers = 64;
 
-QVector<int> parseNumbers(const QString &input)
+// the numbers of text, in buffer or in overflow if they do not all fit
+std::span<const int> scanSide(std::string_view text, std::span<int, maxNumbers> buffer, std::vector<int> &overflow)
 {
-    QVector<int> numbers;
-    for (const auto numStrings = input.split(" ", Qt::SkipEmptyParts); const auto &s : numStrings)
-        numbers.append(s.toInt());
-    return numbers;
+    const auto count = utils::scanNumbers(text, buffer);
+    if (count < buffer.size())
+        return buffer.first(count);
+    // a full buffer may have cut the numbers short
+    overflow.clear();
+    utils::appendNumbers(text, overflow);
+    return overflow;
 }
 
-QPair<QVector<int>, QVector<int>> parseLine(const QString &line)
+// how many of the winning numbers of a card are among its own numbers
+int matchCount(std::string_view line)
 {
-    const auto setStrings = line.mid(line.indexOf(":") + 1).split("|");
-    return {parseNumbers(setStrings.at(0)), parseNumbers(setStrings.at(1))};
+    const auto [winningText, ownText] = utils::splitFixed<2>(line.substr(line.find(':') + 1), '|');
+
+    std::array<int, maxNumbers> winningBuffer;
+    std::array<int, maxNumbers> ownBuffer;
+    std::vector<int>            winningOverflow;
+    std::vector<int>            ownOverflow;
+
+    const auto winning = scanSide(winningText, winningBuffer, winningOverflow);
+    const auto own     = scanSide(ownText, ownBuffer, ownOverflow);
+
+    return static_cast<int>(
+        std::ranges::count_if(winning, [own](int number) { return std::ranges::find(own, number) != own.end(); }));
 }
 
 QString part1(const QString &fileName)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return {};
-    }
 
-    int sum = 0;
-    while (!file.atEnd()) {
-        const auto &[winningNumbers, numbers] = parseLine(file.readLine().trimmed());
-        const auto matchedNumbers             = intersect(winningNumbers, numbers);
-        sum += matchedNumbers.isEmpty() ? 0 : (1 << (matchedNumbers.size() - 1));
-    }
+    const auto points = [](std::string_view line) {
+        const auto matches = matchCount(utils::trimmed(line));
+        return matches == 0 ? 0 : (1 << (matches - 1));
+    };
+
+    // cards are parsed and scored in one pass, in parallel; incrementally only
+    // the cards appended since the last run
+    probe.next("solve");
+    const auto sum = utils::incrementalReduce<int>(
+        "day04-part1", 1, fileName, input.data(),
+        [&points](int &total, std::string_view lines) { total += utils::parallelLinesReduce<int>(lines, points); });
 
     return QString::number(sum);
 }
 
-QString part2(const QString &fileName)
+// A card only wins copies of as many cards ahead as it has matches, so the
+// copies won for the cards ahead fit into a ring indexed by the card number,
+// which grows for cards with more matches than it has room for. The ring is part
+// of the state, so that appended cards still receive the copies won by the
+// cards before them.
+struct Copies
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
-        return {};
-    }
+    // bump stateVersion when the serialized members change
+    static constexpr quint32 stateVersion = 2;
 
-    QStringList lines;
-    while (!file.atEnd())
-        lines.append(file.readLine().trimmed());
+    std::vector<int> pendingCopies = std::vector<int>(maxNumbers + 1, 0);
+    quint64          card          = 0;
+    int              total         = 0;
 
-    QVector<int> instances(lines.size(), 1);
-    for (int curLine = 0; curLine < lines.size(); curLine++) {
-        const auto &[winningNumbers, numbers] = parseLine(lines.at(curLine));
-        const auto matchedNumbers             = intersect(winningNumbers, numbers);
-        for (int i = 0; i < matchedNumbers.size(); ++i)
-            instances[curLine + i + 1] += instances[curLine];
+    template<typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(pendingCopies, card, total);
     }
 
-    return QString::number(std::accumulate(instances.begin(), instances.end(), 0));
-}
+    // a card with more matches than the ring has room for, the copies of the
+    // cards ahead stay at their card number modulo the new size
+    void grow(std::size_t size)
+    {
+        std::vector<int> grown(size, 0);
+        for (std::size_t i = 0; i < pendingCopies.size(); ++i)
+            grown[(card + i) % size] = pendingCopies[(card + i) % pendingCopies.size()];
+        pendingCopies = std::move(grown);
+    }
 
-} // namespace Day04
+    void add(std::string_view lines)
+    {
+        for (const auto rawLine : utils::Lines(lines)) {
+            const auto line = utils::trimmed(rawLine);
+            if (line.empty())
+                continue;
+
+            auto      &pending   = pendingCopies[card % pendingCopies.size()];
+            const auto instances = 1 + std::exchange(pending, 0);
+            total += instances;
+
+            const auto matches = static_cast<std::size_t>(matchCount(line));
+            if (matches >= pendingCopies.size())
+                grow(matches + 1);
+            for (std::size_t i = 1; i <= matches; ++i)
+                pendingCopies[(card + i) % pendingCopies.size()] += instances;
+            ++card;
+        }
+    }
+};
 
-int main()
+QString part2(const QString &fileName)
 {
-    qInfo() << "Part 1:" << Day04::part1(":/input.txt");
-    qInfo() << "Part 2:" << Day04::part2(":/input.txt");
-    return 0;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    probe.next("solve");
+    const auto copies = utils::incrementalReduce<Copies>(
+        "day04-part2", Copies::stateVersion, fileName, input.data(),
+        [](Copies &state, std::string_view lines) { state.add(lines); });
+
+    return QString::number(copies.total);
 }
+
+} // namespace Day04
@@ -0,0 +1,8 @@
+#include "day04.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day04::part1, Day04::part2);
+}
@@ -1,10 +1,23 @@
+#include "day05.h"
+
 #include "literals.h"
+#include "mappedinput.h"
+#include "numbers.h"
+#include "probes.h"
+#include "stringutils.h"
+#include "taskpool.h"
 
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
 using namespace utils::literals::integer;
 
 namespace Day05 {
@@ -91,20 +104,18 @@ struct Map
     }
 };
 
-RangeMap parseRangeMap(const QString &line)
+RangeMap parseRangeMap(std::string_view line)
 {
-    auto parts = line.split(' ', Qt::SkipEmptyParts);
-    assert(parts.size() == 3);
-    return {parts.at(1).toLongLong(), parts.at(2).toLongLong(), parts.at(0).toLongLong()};
+    std::array<qint64, 3> numbers{};
+    utils::scanNumbers(line, std::span(numbers));
+    const auto [target, start, length] = numbers;
+    return {start, length, target};
 }
 
-QVector<qint64> parseSeed(const QString &line)
+QVector<qint64> parseSeed(std::string_view line)
 {
-    auto            seedsString = line.mid(line.indexOf(":") + 1).trimmed();
-    auto            seeds       = seedsString.split(' ', Qt::SkipEmptyParts);
     QVector<qint64> ret;
-    for (auto const &s : seeds)
-        ret.append(s.toLongLong());
+    utils::appendNumbers(line.substr(line.find(':') + 1), ret);
     return ret;
 }
 
@@ -115,20 +126,18 @@ struct Data
 
     static Data parse(const QString &fileName)
     {
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            qWarning() << "Failed to open file" << fileName;
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
             return {};
-        }
 
         Data ret;
-        while (!file.atEnd()) {
-            const QString line = file.readLine().trimmed();
-            if (line.startsWith("seeds:"))
+        for (const auto rawLine : input.lines()) {
+            const auto line = utils::trimmed(rawLine);
+            if (line.starts_with("seeds:"))
                 ret.seeds = parseSeed(line);
-            else if (line.contains("-to-"))
+            else if (line.find("-to-") != std::string_view::npos)
                 ret.maps.append(Map{});
-            else if (line.isEmpty())
+            else if (line.empty())
                 continue;
             else
                 ret.maps.last().map.append(parseRangeMap(line));
@@ -148,7 +157,9 @@ struct Data
 
 QString part1(const QString &fileName)
 {
+    utils::PhaseProbe probe("parse");
     auto data = Data::parse(fileName);
+    probe.next("solve");
     qint64 result = std::numeric_limits<qint64>::max();
     for (const auto &seed: data.seeds) {
         qint64 location = seed;
@@ -159,18 +170,17 @@ QString part1(const QString &fileName)
     return QString::number(result);
 }
 
-QString part2(const QString &fileName)
+// lowest location of the seeds in the range
+qint64 lowestLocation(const RangeMap &seeds, const QVector<Map> &maps)
 {
-    auto data = Data::parse(fileName);
-    QVector<RangeMap> sources = data.seedToRanges();
-
-    for (auto &map: data.maps) {
+    QVector<RangeMap> sources{seeds};
+    for (const auto &map : maps) {
         QVector<RangeMap> results;
-        for (auto &source : sources) {
-            QVector<RangeMap> current {source};
-            for (auto &mapRanges : map.map) {
+        for (const auto &source : sources) {
+            QVector<RangeMap> current{source};
+            for (const auto &mapRanges : map.map) {
                 QVector<RangeMap> remaining;
-                for (auto &currentRange : current) {
+                for (const auto &currentRange : current) {
                     remaining.append(mapRanges.nonMappedRanges(currentRange));
                     auto filtered = mapRanges.filteredRange(currentRange);
                     if (filtered.length == 0)
@@ -183,15 +193,27 @@ QString part2(const QString &fileName)
         }
         sources = results;
     }
-
-    return QString::number(std::min_element(sources.begin(), sources.end())->start);
+    return std::min_element(sources.begin(), sources.end())->start;
 }
 
-} // namespace Day05
-
-int main()
+QString part2(const QString &fileName)
 {
-    qInfo() << "Part 1:" << Day05::part1(":/input.txt");
-    qInfo() << "Part 2:" << Day05::part2(":/input.txt");
-    return 0;
+    utils::PhaseProbe probe("parse");
+    auto data = Data::parse(fileName);
+    probe.next("transform");
+    const QVector<RangeMap> sources = data.seedToRanges();
+    probe.next("solve");
+    if (sources.isEmpty())
+        return {};
+
+    // the seed ranges are mapped independently of each other, in parallel
+    std::vector<qint64> locations(static_cast<std::size_t>(sources.size()), std::numeric_limits<qint64>::max());
+    utils::parallelFor(0, locations.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i)
+            locations[i] = lowestLocation(sources.at(static_cast<qsizetype>(i)), data.maps);
+    });
+
+    return QString::number(std::ranges::min(locations));
 }
+
+} // namespace Day05
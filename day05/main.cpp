@@ -0,0 +1,8 @@
+#include "day05.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day05::part1, Day05::part2);
+}
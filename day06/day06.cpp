@@ -1,10 +1,16 @@
+#include "day06.h"
+
 #include "literals.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
 
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
+#include <string_view>
+
 using namespace utils::literals::integer;
 
 namespace Day06 {
@@ -31,50 +37,70 @@ struct Race
     }
 };
 
-QPair<QStringList, QStringList> parseTimesAndDistances(const QString &fileName)
-{
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
-        return {};
-    }
+using Numbers = QVector<std::string_view>;
 
-    QStringList times;
-    QStringList distances;
+Numbers parseNumbers(std::string_view line)
+{
+    Numbers numbers;
+    for (const auto number : utils::split(line.substr(line.find(':') + 1), ' ', Qt::SkipEmptyParts))
+        numbers.append(number);
+    return numbers;
+}
 
-    while (!file.atEnd()) {
-        QString line = file.readLine().trimmed();
-        if (line.startsWith("Time:"))
-            times = line.mid(line.indexOf(':') + 1).split(' ', Qt::SkipEmptyParts);
-        else if (line.startsWith("Distance:"))
-            distances = line.mid(line.indexOf(':') + 1).split(' ', Qt::SkipEmptyParts);
+QPair<Numbers, Numbers> parseTimesAndDistances(const utils::MappedInput &input)
+{
+    Numbers times;
+    Numbers distances;
+
+    for (const auto rawLine : input.lines()) {
+        const auto line = utils::trimmed(rawLine);
+        if (line.starts_with("Time:"))
+            times = parseNumbers(line);
+        else if (line.starts_with("Distance:"))
+            distances = parseNumbers(line);
     }
 
     return {times, distances};
 }
 
-QVector<Race> parseRaces(const QString &fileName)
+// the digits of all numbers read as one number, ignoring the spaces in between
+qint64 joinedNumber(const Numbers &numbers)
+{
+    qint64 result = 0;
+    for (const auto number : numbers)
+        for (const auto c : number)
+            result = result * 10 + (c - '0');
+    return result;
+}
+
+QVector<Race> parseRaces(const utils::MappedInput &input)
 {
     QVector<Race> ret;
 
-    auto [times, distances] = parseTimesAndDistances(fileName);
+    auto [times, distances] = parseTimesAndDistances(input);
     Q_ASSERT(times.size() == distances.size());
     for (int i = 0; i < times.size(); i++)
-        ret.append({times[i].toLongLong(), distances[i].toLongLong()});
+        ret.append({utils::toNumber<qint64>(times[i]), utils::toNumber<qint64>(distances[i])});
 
     return ret;
 }
 
-Race parseRacePart2(const QString &fileName)
+Race parseRacePart2(const utils::MappedInput &input)
 {
-    auto [times, distances] = parseTimesAndDistances(fileName);
+    auto [times, distances] = parseTimesAndDistances(input);
     Q_ASSERT(times.size() == distances.size());
-    return {times.join("").toLongLong(), distances.join("").toLongLong()};
+    return {joinedNumber(times), joinedNumber(distances)};
 }
 
 QString part1(const QString &fileName)
 {
-    auto races = parseRaces(fileName);
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    auto races = parseRaces(input);
+    probe.next("solve");
     return QString::number(
         std::accumulate(races.begin(), races.end(), 1_i64, [](qint64 i, const Race &race) {
             return i * race.betterDistances();
@@ -83,14 +109,14 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    return QString::number(parseRacePart2(fileName).betterDistances());
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    const auto race = parseRacePart2(input);
+    probe.next("solve");
+    return QString::number(race.betterDistances());
 }
 
 } // namespace Day06
-
-int main()
-{
-    qInfo() << "Part 1:" << Day06::part1(":/input.txt");
-    qInfo() << "Part 2:" << Day06::part2(":/input.txt");
-    return 0;
-}
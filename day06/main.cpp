@@ -0,0 +1,8 @@
+#include "day06.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, Day06::part1, Day06::part2);
+}
@@ -1,16 +1,23 @@
+#include "day07.h"
+
 #include "literals.h"
+#include "lookuptable.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
+#include <string_view>
+
 using namespace utils::literals::integer;
 
 namespace day07 {
 
 Q_NAMESPACE
 
-static const QMap<QChar, int> cardValues{
+constexpr utils::LookupTable<char, int> cardValues{
     {'2', 2 },
     {'3', 3 },
     {'4', 4 },
@@ -45,14 +52,15 @@ struct Hand
     quint64 bid   = 0;
     bool    joker = false;
 
-    static Hand fromString(const QString &line, bool joker = false)
+    static Hand fromString(std::string_view line, bool joker = false)
     {
         Hand       result;
-        const auto sep = line.split(" ");
-        Q_ASSERT(sep.size() == 2);
-        result.cards = sep[0];
-        result.bid   = sep[1].toInt();
-        result.joker = joker;
+        const auto [cards, bid] = utils::splitFixed<2>(line, ' ');
+        result.cards            = utils::toQString(cards);
+        result.bid              = utils::toNumber<quint64>(bid);
+        result.joker            = joker;
+        if (joker)
+            result.cards.replace('J', 'X');
         return result;
     }
 
@@ -84,7 +92,8 @@ struct Hand
 
                 auto keys = maxCards.keys();
                 // convert to values
-                auto maxIt = std::ranges::max_element(keys, {}, [&](const auto &key) { return cardValues[key]; });
+                auto maxIt = std::ranges::max_element(keys, {},
+                                                      [](const auto &key) { return cardValues[key.toLatin1()]; });
                 if (maxIt != keys.end()) {
                     cardCounts[*maxIt] += cnt;
                 } else {
@@ -121,8 +130,10 @@ struct Hand
             return rank() < other.rank();
 
         for (int i = 0; i < cards.size(); ++i) {
-            if (cardValues[cards[i]] != cardValues[other.cards[i]])
-                return cardValues[cards[i]] < cardValues[other.cards[i]];
+            const auto value      = cardValues[cards[i].toLatin1()];
+            const auto otherValue = cardValues[other.cards[i].toLatin1()];
+            if (value != otherValue)
+                return value < otherValue;
         }
         return false;
     }
@@ -130,25 +141,24 @@ struct Hand
 
 QVector<Hand> parse(const QString &fileName, bool joker = false)
 {
-    QVector<Hand> result;
-    QFile         file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file" << fileName;
+    QVector<Hand>            result;
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return {};
-    }
-    while (!file.atEnd()) {
-        QString line = file.readLine().trimmed();
-        if (joker)
-            line.replace('J', 'X');
-        result.append(Hand::fromString(line, joker));
+    for (const auto line : input.lines()) {
+        if (const auto hand = utils::trimmed(line); !hand.empty())
+            result.append(Hand::fromString(hand, joker));
     }
     return result;
 }
 
 QString part1(const QString &fileName)
 {
-    auto hands = parse(fileName);
+    utils::PhaseProbe probe("parse");
+    auto              hands = parse(fileName);
+    probe.next("transform");
     std::sort(hands.begin(), hands.end());
+    probe.next("solve");
     quint64 rank = 1;
     return QString::number(std::accumulate(hands.begin(), hands.end(), 0_u64, [&rank](quint64 sum, const auto &hand) {
         return sum + rank++ * hand.bid;
@@ -157,8 +167,11 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    auto hands = parse(fileName, true);
+    utils::PhaseProbe probe("parse");
+    auto              hands = parse(fileName, true);
+    probe.next("transform");
     std::sort(hands.begin(), hands.end());
+    probe.next("solve");
     quint64 rank = 1;
     return QString::number(std::accumulate(hands.begin(), hands.end(), 0_u64, [&rank](quint64 sum, const auto &hand) {
         return sum + rank++ * hand.bid;
@@ -167,10 +180,4 @@ QString part2(const QString &fileName)
 
 } // namespace day07
 
-int main()
-{
-    qDebug() << "Part 1: " << day07::part1(":/input.txt");
-    qDebug() << "Part 2: " << day07::part2(":/input.txt");
-}
-
-#include "day07.moc"
\ No newline at end of file
+#include "day07.moc"
@@ -0,0 +1,8 @@
+#include "day07.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day07::part1, day07::part2);
+}
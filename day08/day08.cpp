@@ -1,28 +1,52 @@
+#include "day08.h"
+
+#include "interner.h"
 #include "literals.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "snapshot.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
-#include <QHash>
-#include <QRegularExpression>
 #include <QString>
 #include <QVector>
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <string_view>
+
 using namespace utils::literals::integer;
 
 namespace day08 {
 
 enum class Instruction { Left, Right };
 
+// the element names are interned at parse time, elements refer to each other by id
 struct Element
 {
-    QString                    name;
-    QMap<Instruction, QString> next;
+    std::array<utils::Interner::Id, 2> next{utils::Interner::invalid, utils::Interner::invalid};
+    // whether the name ends with 'A' or 'Z', the start and the goal of the ghosts
+    bool isGhostStart = false;
+    bool isGhostGoal  = false;
 };
 
 struct Program
 {
-    QVector<Instruction>    instructions;
-    QHash<QString, Element> elements;
-    int                     currentInstruction = 0;
+    QVector<Instruction> instructions;
+    QVector<Element>     elements; // indexed by id
+    utils::Interner::Id  start              = utils::Interner::invalid; // AAA
+    utils::Interner::Id  goal               = utils::Interner::invalid; // ZZZ
+    int                  currentInstruction = 0;
+
+    // bump snapshotVersion when the serialized members change
+    static constexpr quint32 snapshotVersion = 2;
+
+    template<typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(instructions, elements, start, goal);
+    }
 
     Instruction update()
     {
@@ -31,24 +55,56 @@ struct Program
         return ret;
     }
 
+    [[nodiscard]] utils::Interner::Id next(utils::Interner::Id element, Instruction instruction) const
+    {
+        return elements[element].next[static_cast<std::size_t>(instruction)];
+    }
+
+    // "AAA = (BBB, CCC)"
+    void parseElement(std::string_view line, utils::Interner &names)
+    {
+        const auto assign = line.find('=');
+        const auto open   = line.find('(', assign);
+        const auto comma  = line.find(',', open);
+        const auto close  = line.find(')', comma);
+        const auto name   = utils::trimmed(line.substr(0, assign));
+        const auto id     = names.intern(name);
+        const auto left   = names.intern(utils::trimmed(line.substr(open + 1, comma - open - 1)));
+        const auto right  = names.intern(utils::trimmed(line.substr(comma + 1, close - comma - 1)));
+
+        if (elements.size() < names.size())
+            elements.resize(names.size());
+        elements[id] = {
+            {left, right},
+            name.ends_with('A'),
+            name.ends_with('Z'),
+        };
+    }
+
     static Program parse(const QString &fileName)
     {
-        QFile file(fileName);
-        Q_ASSERT(file.open(QIODevice::ReadOnly | QIODevice::Text));
-        Program ret;
+        const utils::MappedInput input(fileName);
+        Q_ASSERT(input.isOpen());
+        return utils::cachedParse<Program>("day08", snapshotVersion, input.data(), [&input] { return parse(input); });
+    }
+
+    static Program parse(const utils::MappedInput &input)
+    {
+        Program         ret;
+        utils::Interner names;
 
         enum class State { Instruction, Elements };
         State state = State::Instruction;
 
-        while (!file.atEnd()) {
-            const QString line = file.readLine().trimmed();
-            if (line.isEmpty()) {
+        for (const auto rawLine : input.lines()) {
+            const auto line = utils::trimmed(rawLine);
+            if (line.empty()) {
                 state = State::Elements;
                 continue;
             }
 
             if (state == State::Instruction) {
-                for (const auto &c : line) {
+                for (const auto c : line) {
                     if (c == 'L')
                         ret.instructions.append(Instruction::Left);
                     else if (c == 'R')
@@ -57,38 +113,37 @@ struct Program
                         Q_ASSERT(false);
                 }
             } else {
-                QRegularExpression re(R"((\w+)\s*=\s*\((\w+),\s*(\w+)\))");
-                auto               m = re.match(line);
-                ret.elements.insert(m.captured(1),
-                                    {
-                                        m.captured(1),
-                                        {{Instruction::Left, m.captured(2)}, {Instruction::Right, m.captured(3)}}
-                });
+                ret.parseElement(line, names);
+            }
+        }
+
+        // elements that are only referenced lead to themselves
+        ret.elements.resize(names.size());
+        for (qsizetype id = 0; id < ret.elements.size(); ++id) {
+            for (auto &next : ret.elements[id].next) {
+                if (next == utils::Interner::invalid)
+                    next = static_cast<utils::Interner::Id>(id);
             }
         }
+        ret.start = names.find("AAA");
+        ret.goal  = names.find("ZZZ");
         return ret;
     }
 };
 
-QVector<Element> elementsEndingWith(QChar c, const Program &program)
-{
-    QVector<Element> ret;
-    for (const auto &e : program.elements) {
-        if (e.name.endsWith(c))
-            ret.append(e);
-    }
-    return ret;
-}
-
 QString part1(const QString &fileName)
 {
-    auto program        = Program::parse(fileName);
-    auto currentElement = program.elements["AAA"];
+    utils::PhaseProbe probe("parse");
+    auto              program = Program::parse(fileName);
+    probe.next("solve");
+    if (program.start == utils::Interner::invalid || program.goal == utils::Interner::invalid)
+        return QString::number(0);
+
+    auto currentElement = program.start;
     int  steps          = 0;
 
-    while (currentElement.name != "ZZZ") {
-        auto instruction = program.update();
-        currentElement   = program.elements[currentElement.next[instruction]];
+    while (currentElement != program.goal) {
+        currentElement = program.next(currentElement, program.update());
         steps++;
     }
 
@@ -97,19 +152,25 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    auto             program         = Program::parse(fileName);
-    quint64          steps           = 0;
-    auto             currentElements = elementsEndingWith('A', program);
+    utils::PhaseProbe probe("parse");
+    auto              program = Program::parse(fileName);
+    probe.next("solve");
+    quint64                      steps = 0;
+    QVector<utils::Interner::Id> currentElements;
+    for (qsizetype id = 0; id < program.elements.size(); ++id) {
+        if (program.elements[id].isGhostStart)
+            currentElements.append(static_cast<utils::Interner::Id>(id));
+    }
     QVector<quint64> counts(currentElements.size());
 
     while (std::ranges::any_of(counts, [](const auto &c) { return c == 0; })) {
         auto instruction = program.update();
         for (int i = 0; i < currentElements.size(); ++i) {
-            if (currentElements[i].name.endsWith('Z') && counts[i] == 0) {
+            if (program.elements[currentElements[i]].isGhostGoal && counts[i] == 0) {
                 counts[i] = steps;
                 continue;
             }
-            currentElements[i] = program.elements[currentElements[i].next[instruction]];
+            currentElements[i] = program.next(currentElements[i], instruction);
         }
         steps++;
     }
@@ -120,9 +181,3 @@ QString part2(const QString &fileName)
 }
 
 } // namespace day08
-
-int main()
-{
-    qDebug() << "Part 1: " << day08::part1(":/input.txt");
-    qDebug() << "Part 2: " << day08::part2(":/input.txt");
-}
@@ -0,0 +1,8 @@
+#include "day08.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day08::part1, day08::part2);
+}
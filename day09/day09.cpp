@@ -1,90 +1,110 @@
+#include "day09.h"
+
+#include "arena.h"
+#include "incremental.h"
+#include "mappedinput.h"
+#include "numbers.h"
+#include "parallel.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
-#include <QVector>
+
+#include <algorithm>
+#include <string_view>
 
 namespace day09 {
 
 struct Sequence
 {
-    QVector<QVector<qint64>> numbers;
+    // the input line followed by its differences, all allocated from one arena
+    utils::ArenaVector<utils::ArenaVector<qint64>> numbers;
 
-    static Sequence fromLine(const QString &line)
+    static Sequence fromLine(std::string_view line, utils::ArenaAllocator allocator)
     {
-        Sequence        result;
-        QVector<qint64> inputLine;
-        const auto      numbers = line.split(' ', Qt::SkipEmptyParts);
-        for (const auto &number : numbers)
-            inputLine.append(number.toLongLong());
-        result.numbers.append(inputLine);
+        Sequence                   result{decltype(numbers)(allocator)};
+        utils::ArenaVector<qint64> inputLine(allocator);
+        // room for the extrapolated value
+        inputLine.reserve(std::ranges::count(line, ' ') + 2);
+        utils::appendNumbers(line, inputLine);
+        result.numbers.reserve(inputLine.size() + 1);
+        result.numbers.push_back(std::move(inputLine));
         return result;
     }
 
     [[nodiscard]] bool isFinished() const
     {
-        return std::all_of(numbers.last().begin(), numbers.last().end(), [](qint64 number) { return number == 0; });
+        return std::all_of(numbers.back().begin(), numbers.back().end(), [](qint64 number) { return number == 0; });
     }
 
     void analyze()
     {
         while (!isFinished()) {
-            const auto     &lastLine = numbers.last();
-            QVector<qint64> newLine;
-            for (int i = 0; i < lastLine.size() - 1; ++i)
-                newLine.append(lastLine[i + 1] - lastLine[i]);
-            numbers.append(newLine);
+            const auto                &lastLine = numbers.back();
+            utils::ArenaVector<qint64> newLine(numbers.get_allocator());
+            newLine.reserve(lastLine.size());
+            for (std::size_t i = 0; i + 1 < lastLine.size(); ++i)
+                newLine.push_back(lastLine[i + 1] - lastLine[i]);
+            numbers.push_back(std::move(newLine));
         }
     }
 
     qint64 extrapolateRight()
     {
-        for (int i = numbers.size() - 1; i > 0; --i)
-            numbers[i - 1].append(numbers[i - 1].last() + numbers[i].last());
-        return numbers[0].last();
+        for (auto i = numbers.size() - 1; i > 0; --i)
+            numbers[i - 1].push_back(numbers[i - 1].back() + numbers[i].back());
+        return numbers[0].back();
     }
 
     qint64 extrapolateLeft()
     {
-        for (int i = numbers.size() - 1; i > 0; --i)
-            numbers[i - 1].prepend(numbers[i - 1].first() - numbers[i].first());
-        return numbers[0].first();
+        for (auto i = numbers.size() - 1; i > 0; --i)
+            numbers[i - 1].insert(numbers[i - 1].begin(), numbers[i - 1].front() - numbers[i].front());
+        return numbers[0].front();
     }
 };
 
-QVector<Sequence> fromFile(const QString &fileName)
+// stateName identifies the incremental state, each part has its own
+template<typename Extrapolate>
+QString process(const QString &fileName, const char *stateName, Extrapolate extrapolate)
 {
-    QVector<Sequence> result;
-    QFile             file(fileName);
-    Q_ASSERT(file.open(QIODevice::ReadOnly | QIODevice::Text));
-    while (!file.atEnd())
-        result.append(Sequence::fromLine(file.readLine().trimmed()));
-    return result;
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    const auto predict = [&extrapolate](std::string_view rawLine) {
+        const auto line = utils::trimmed(rawLine);
+        if (line.empty())
+            return qint64{0};
+
+        static thread_local utils::Arena arena;
+        arena.release();
+        auto sequence = Sequence::fromLine(line, arena.allocator());
+        sequence.analyze();
+        return extrapolate(sequence);
+    };
+
+    // every sequence is parsed, analyzed and extrapolated on its own, in
+    // parallel; each thread reuses its own arena for them. Incrementally only
+    // the sequences appended since the last run.
+    probe.next("solve");
+    const auto sum = utils::incrementalReduce<qint64>(
+        stateName, 1, fileName, input.data(), [&predict](qint64 &total, std::string_view lines) {
+            total += utils::parallelLinesReduce<qint64>(lines, predict);
+        });
+    return QString::number(sum);
 }
 
 QString part1(const QString &fileName)
 {
-    qint64 sum = 0;
-    for (auto &sequence : fromFile(fileName)) {
-        sequence.analyze();
-        sum += sequence.extrapolateRight();
-    }
-    return QString::number(sum);
+    return process(fileName, "day09-part1", [](Sequence &sequence) { return sequence.extrapolateRight(); });
 }
 
 QString part2(const QString &fileName)
 {
-    qint64 sum = 0;
-    for (auto &sequence : fromFile(fileName)) {
-        sequence.analyze();
-        sum += sequence.extrapolateLeft();
-    }
-    return QString::number(sum);
+    return process(fileName, "day09-part2", [](Sequence &sequence) { return sequence.extrapolateLeft(); });
 }
 
 } // namespace day09
-
-int main()
-{
-    qDebug() << "Part 1: " << day09::part1(":/input.txt");
-    qDebug() << "Part 2: " << day09::part2(":/input.txt");
-}
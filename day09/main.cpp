@@ -0,0 +1,8 @@
+#include "day09.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day09::part1, day09::part2);
+}
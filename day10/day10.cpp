@@ -1,12 +1,19 @@
+#include "day10.h"
+
+#include "grid.h"
+#include "lookuptable.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "smallvector.h"
+#include "snapshot.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
-#include <QHash>
-#include <QMap>
 #include <QObject>
 #include <QString>
-#include <QVector>
 
 #include <algorithm>
+#include <queue>
 
 namespace day10 {
 
@@ -34,62 +41,71 @@ enum class Direction {
 
 Q_ENUM_NS(Direction)
 
-struct Point
-{
-    int x = 0;
-    int y = 0;
-
-    bool operator<(const Point &other) const { return x < other.x || (x == other.x && y < other.y); }
-};
+using Point = utils::Point;
 
-QMap<QChar, Tile> parserMap{
-    {'|', Tile::VerticalPipe  },
-    {'-', Tile::HorizontalPipe},
-    {'L', Tile::BendNorthEast },
-    {'J', Tile::BendNorthWest },
-    {'F', Tile::BendSouthEast },
-    {'7', Tile::BendSouthWest },
-    {'.', Tile::Ground        },
-    {'S', Tile::Start         },
-};
+// unknown characters are ground
+constexpr utils::LookupTable<char, Tile> parserMap(
+    {
+        {'|', Tile::VerticalPipe  },
+        {'-', Tile::HorizontalPipe},
+        {'L', Tile::BendNorthEast },
+        {'J', Tile::BendNorthWest },
+        {'F', Tile::BendSouthEast },
+        {'7', Tile::BendSouthWest },
+        {'.', Tile::Ground        },
+        {'S', Tile::Start         },
+},
+    Tile::Ground);
 
-using Map = QMap<Point, Tile>;
+// surrounded by a ring of ground, so every step from a tile stays addressable
+using Map = utils::Grid<Tile>;
 
 struct ParserResult
 {
     Map   map;
     Point start;
+
+    // bump snapshotVersion when the serialized members change
+    static constexpr quint32 snapshotVersion = 1;
+
+    template<typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(map, start);
+    }
 };
 
 std::optional<Tile> convertStart(const Map &map, const Point &startPoint);
 
-ParserResult parseFile(const QString &fileName)
+ParserResult parseInput(const utils::MappedInput &input)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Failed to open file: " << fileName;
-        return {};
-    }
-
     ParserResult result;
-    Point        point;
-    while (!file.atEnd()) {
-        const QString line = file.readLine().trimmed();
-        for (const QChar c : line) {
-            result.map.insert(point, parserMap[c]);
-            if (c == 'S')
-                result.start = point;
-            point.x++;
-        }
-        point.x = 0;
-        point.y++;
-    }
+    result.map = Map::fromLines(
+        input.lines(),
+        [](char c) { return parserMap[c]; },
+        1,
+        Tile::Ground);
+    const auto start = result.map.find(Tile::Start);
+    const auto tile  = start ? convertStart(result.map, *start) : std::nullopt;
+    if (!tile)
+        return {};
 
-    result.map[result.start] = *convertStart(result.map, result.start);
+    result.start             = *start;
+    result.map[result.start] = *tile;
 
     return result;
 }
 
+ParserResult parseFile(const QString &fileName)
+{
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+    return utils::cachedParse<ParserResult>("day10", ParserResult::snapshotVersion, input.data(), [&input] {
+        return parseInput(input);
+    });
+}
+
 Point move(const Point &point, Direction direction)
 {
     switch (direction) {
@@ -105,7 +121,10 @@ Point move(const Point &point, Direction direction)
     return {};
 }
 
-QVector<Direction> directions(Tile tile)
+// a pipe connects two directions, the others none
+using Directions = utils::SmallVector<Direction, 2>;
+
+Directions directions(Tile tile)
 {
     switch (tile) {
     case Tile::VerticalPipe:
@@ -143,7 +162,7 @@ Direction invertedDirection(Direction in)
 std::optional<Point> canMove(const Map &map, const Point &point, Direction to)
 {
     const auto pointTo = move(point, to);
-    auto       res     = map.contains(pointTo) && directions(map.value(pointTo)).contains(invertedDirection(to));
+    auto       res     = directions(map[pointTo]).contains(invertedDirection(to));
     return res ? std::optional<Point>(pointTo) : std::nullopt;
 }
 
@@ -164,19 +183,23 @@ std::optional<Tile> convertStart(const Map &map, const Point &startPoint)
     return {};
 }
 
-QMap<Point, int> createVisitedMap(const Map &map, const Point &start)
+// distance of every loop tile from start, -1 for tiles outside of the loop
+utils::Grid<int> createVisitedMap(const Map &map, const Point &start)
 {
-    QMap<Point, int> visited;
+    utils::Grid<int> visited(map.width(), map.height(), -1);
+    visited[start] = 0;
 
-    QVector<Point> pointsToVisit = {start};
-    while (!pointsToVisit.isEmpty()) {
-        const Point point         = pointsToVisit.takeFirst();
-        const int   pointDistance = visited.value(point, 0);
-        for (const Direction direction : directions(map.value(point))) {
+    std::queue<Point> pointsToVisit;
+    pointsToVisit.push(start);
+    while (!pointsToVisit.empty()) {
+        const Point point         = pointsToVisit.front();
+        const int   pointDistance = visited[point];
+        pointsToVisit.pop();
+        for (const Direction direction : directions(map[point])) {
             if (auto pointTo = canMove(map, point, direction)) {
-                if (!visited.contains(*pointTo)) {
-                    visited.insert(*pointTo, pointDistance + 1);
-                    pointsToVisit.append(*pointTo);
+                if (visited[*pointTo] < 0) {
+                    visited[*pointTo] = pointDistance + 1;
+                    pointsToVisit.push(*pointTo);
                 }
             }
         }
@@ -187,41 +210,49 @@ QMap<Point, int> createVisitedMap(const Map &map, const Point &start)
 
 QString part1(const QString &fileName)
 {
+    utils::PhaseProbe probe("parse");
     const auto [map, start] = parseFile(fileName);
-    const auto visited      = createVisitedMap(map, start);
-    return QString::number(*std::ranges::max_element(visited, [](const auto &a, const auto &b) { return a < b; }));
+    if (map.isEmpty())
+        return {};
+    probe.next("solve");
+    const auto visited = createVisitedMap(map, start);
+
+    int result = 0;
+    for (int y = 0; y < visited.height(); ++y)
+        result = std::max(result, std::ranges::max(visited.row(y)));
+    return QString::number(result);
 }
 
 QString part2(const QString &fileName)
 {
+    utils::PhaseProbe probe("parse");
     const auto [map, start] = parseFile(fileName);
-    const auto visited      = createVisitedMap(map, start);
-    // ray-casting algorithm
-    const auto cntInv = [&](const Point &point) {
-        int count = 0;
-        for (int i = 0; i < point.x; ++i) {
-            const Point p = {i, point.y};
-            if (!visited.contains(p))
+    if (map.isEmpty())
+        return {};
+    probe.next("transform");
+    const auto visited = createVisitedMap(map, start);
+    probe.next("solve");
+
+    // ray-casting algorithm: a tile is inside if an odd number of loop tiles
+    // facing north lies to its left
+    qint64 count = 0;
+    for (int y = 0; y < map.height(); ++y) {
+        const auto tiles     = map.row(y);
+        const auto distances = visited.row(y);
+        bool       inside    = false;
+        for (std::size_t x = 0; x < tiles.size(); ++x) {
+            if (distances[x] < 0) {
+                count += inside ? 1 : 0;
                 continue;
-            auto tile = map.value(p);
+            }
+            const auto tile = tiles[x];
             if (tile == Tile::VerticalPipe || tile == Tile::BendNorthEast || tile == Tile::BendNorthWest)
-                count++;
+                inside = !inside;
         }
-        return count;
-    };
-    const auto is_odd = [](int x) { return x % 2 == 1; };
-
-    return QString::number(std::ranges::count_if(map.keys(), [&](const auto &point) {
-        return !visited.contains(point) && is_odd(cntInv(point));
-    }));
+    }
+    return QString::number(count);
 }
 
 } // namespace day10
 
-int main()
-{
-    qDebug() << "Part 1: " << day10::part1(":/input.txt");
-    qDebug() << "Part 2: " << day10::part2(":/input.txt");
-}
-
 #include "day10.moc"
@@ -0,0 +1,8 @@
+#include "day10.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day10::part1, day10::part2);
+}
@@ -1,5 +1,11 @@
+#include "day11.h"
+
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
+#include <QSet>
 #include <QString>
 #include <QVector>
 
@@ -24,21 +30,19 @@ struct Coordinate
 QVector<Coordinate> parse(const QString& fileName, qint64 extra = 1) 
 {
     QVector<Coordinate> result;
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Could not open file for reading";
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return result;
-    }
 
     qint64 y = 0;
     qint64 max_x = 0;
     QSet<qint64> usedRows;
 
-    while (!file.atEnd()) {
-        const QString line = file.readLine().trimmed();
+    for (const auto rawLine : input.lines()) {
+        const auto line = utils::trimmed(rawLine);
         bool empty = true;
         qint64 x = 0;
-        for (const QChar c : line) {
+        for (const char c : line) {
             if (c == '#') {
                 result.append({x, y});
                 empty = false;
@@ -62,9 +66,13 @@ QVector<Coordinate> parse(const QString& fileName, qint64 extra = 1)
     return result;
 }
 
+namespace reference {
+
 QString part1(const QString& fileName) 
 {
+    utils::PhaseProbe probe("parse");
     auto coordinates = parse(fileName);
+    probe.next("solve");
     qint64 result = 0;
     for (int i = 0; i < coordinates.size(); i++)
         for (int j = i + 1; j < coordinates.size(); j++)
@@ -74,7 +82,9 @@ QString part1(const QString& fileName)
 
 QString part2(const QString& fileName) 
 {
+    utils::PhaseProbe probe("parse");
     auto coordinates = parse(fileName, 999999);
+    probe.next("solve");
     qint64 result = 0;
     for (int i = 0; i < coordinates.size(); i++)
         for (int j = i + 1; j < coordinates.size(); j++)
@@ -82,11 +92,75 @@ QString part2(const QString& fileName)
     return QString::number(result);
 }
 
+} // namespace reference
+
+// Sum of the distances of all pairs of positions on one axis, fed with the
+// positions in ascending order: each new position p is p - q away from every
+// earlier q, which adds p * count - sum.
+class AxisDistances
+{
+public:
+    void add(qint64 position, qint64 galaxies)
+    {
+        _total += galaxies * (position * _count - _sum);
+        _count += galaxies;
+        _sum += galaxies * position;
+    }
+
+    [[nodiscard]] qint64 total() const { return _total; }
+
+private:
+    qint64 _count = 0;
+    qint64 _sum   = 0;
+    qint64 _total = 0;
+};
+
+// The Manhattan distance splits into the x and y distances, so the pairwise
+// sum is the sum of both axes. Rows arrive in order; columns are counted and
+// walked in order afterwards, which makes the whole day O(input).
+qint64 sumOfDistances(const QString &fileName, qint64 extra)
+{
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return 0;
+
+    AxisDistances   rows;
+    QVector<qint64> galaxiesPerColumn;
+    qint64          y = 0;
+    for (const auto rawLine : input.lines()) {
+        const auto line     = utils::trimmed(rawLine);
+        qint64     galaxies = 0;
+        for (qsizetype x = 0; x < static_cast<qsizetype>(line.size()); x++) {
+            if (line[x] != '#')
+                continue;
+            if (galaxiesPerColumn.size() <= x)
+                galaxiesPerColumn.resize(x + 1);
+            galaxiesPerColumn[x]++;
+            galaxies++;
+        }
+        rows.add(y, galaxies);
+        y += 1 + (galaxies == 0 ? extra : 0);
+    }
+
+    probe.next("solve");
+    AxisDistances columns;
+    qint64        x = 0;
+    for (const auto galaxies : galaxiesPerColumn) {
+        columns.add(x, galaxies);
+        x += 1 + (galaxies == 0 ? extra : 0);
+    }
+    return rows.total() + columns.total();
+}
+
+QString part1(const QString& fileName) 
+{
+    return QString::number(sumOfDistances(fileName, 1));
 }
 
-int main()
+QString part2(const QString& fileName) 
 {
-    qDebug() << "Part 1: " << day11::part1(":/input.txt");
-    qDebug() << "Part 2: " << day11::part2(":/input.txt");
+    return QString::number(sumOfDistances(fileName, 999999));
 }
 
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <QString>
+
+namespace day11 {
+
+QString part1(const QString &fileName);
+QString part2(const QString &fileName);
+
+// the original pairwise O(n²) solution, kept to check part1/part2 against
+namespace reference {
+QString part1(const QString &fileName);
+QString part2(const QString &fileName);
+} // namespace reference
+
+} // namespace day11
@@ -0,0 +1,8 @@
+#include "day11.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day11::part1, day11::part2);
+}
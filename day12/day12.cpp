@@ -1,9 +1,18 @@
+#include "day12.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QMap>
 #include <QString>
 #include <QVector>
 
+#include <ranges>
+#include <string_view>
+
+#include "mappedinput.h"
+#include "numbers.h"
+#include "parallel.h"
+#include "probes.h"
+#include "stringutils.h"
 #include "utils.h"
 
 namespace day12 {
@@ -14,23 +23,24 @@ struct TestLine
     QVector<int> expected;
 };
 
-QVector<TestLine> parse(const QString &fileName)
+TestLine parseLine(std::string_view line)
 {
-    QVector<TestLine> result;
-    QFile             file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return result;
+    const auto [record, groups] = utils::splitFixed<2>(utils::trimmed(line), ' ');
+    TestLine testLine;
+    testLine.record = utils::toQString(record);
+    utils::appendNumbers(groups, testLine.expected);
+    return testLine;
+}
 
-    while (!file.atEnd()) {
-        QString     line  = file.readLine().trimmed();
-        QStringList parts = line.split(" ");
-        TestLine    testLine;
-        testLine.record = parts[0];
-        for (auto &numString : parts[1].split(","))
-            testLine.expected.append(numString.toInt());
-        result.append(testLine);
+void unfold(TestLine &testLine)
+{
+    auto      &[record, expected] = testLine;
+    const auto folded             = record;
+    const auto foldedExpected     = expected;
+    for (int i = 0; i < 4; i++) {
+        record += "?" + folded;
+        expected.append(foldedExpected);
     }
-    return result;
 }
 
 qint64 calculateWays(const QString &record, const QVector<int> &expected)
@@ -40,11 +50,14 @@ qint64 calculateWays(const QString &record, const QVector<int> &expected)
         {0, 1}
     };
     for (auto const &[index, contiguous] : utils::enumerate(expected)) {
+        const auto nextExpected = expected | std::views::drop(index + 1);
+        const auto nextSum      = utils::sum(nextExpected);
+        const auto nextCount    = std::ranges::distance(nextExpected);
+
         Positions newPositions;
         for (QMapIterator it(positions); it.hasNext();) {
             it.next();
-            auto nextExpected = expected.mid(index + 1);
-            for (int n = it.key(); n <= (record.length() - utils::sum(nextExpected) + nextExpected.length()); n++) {
+            for (int n = it.key(); n <= (record.length() - nextSum + nextCount); n++) {
                 if ((n + contiguous - 1) < record.length() && !record.mid(n, contiguous).contains('.')) {
                     if ((index == (expected.length() - 1) && !record.mid(n + contiguous).contains('#'))
                         || (index < (expected.length() - 1) && (n + contiguous) < record.length()
@@ -60,35 +73,34 @@ qint64 calculateWays(const QString &record, const QVector<int> &expected)
     return utils::sum(positions);
 }
 
-QString part1(const QString &fileName)
+QString process(const QString &fileName, bool unfolded)
 {
-    auto   testData = parse(fileName);
-    qint64 ways     = 0;
-    for (const auto &[record, expected] : testData)
-        ways += calculateWays(record, expected);
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    // the records are independent, they are parsed and counted in parallel
+    probe.next("solve");
+    const auto ways = utils::parallelLinesReduce<qint64>(input.data(), [unfolded](std::string_view line) {
+        if (utils::trimmed(line).empty())
+            return qint64{0};
+        auto testLine = parseLine(line);
+        if (unfolded)
+            unfold(testLine);
+        return calculateWays(testLine.record, testLine.expected);
+    });
     return QString::number(ways);
 }
 
-QString part2(const QString &fileName)
+QString part1(const QString &fileName)
 {
-    auto   testData = parse(fileName);
-    qint64 ways     = 0;
-    for (const auto &[_record, _expected] : testData) {
-        auto record   = _record;
-        auto expected = _expected;
-        for (int i = 0; i < 4; i++) {
-            record += "?" + _record;
-            expected.append(_expected);
-        }
-        ways += calculateWays(record, expected);
-    }
-    return QString::number(ways);
+    return process(fileName, false);
 }
 
-} // namespace day12
-
-int main()
+QString part2(const QString &fileName)
 {
-    qDebug() << "Part 1: " << day12::part1(":/input.txt");
-    qDebug() << "Part 2: " << day12::part2(":/input.txt");
+    return process(fileName, true);
 }
+
+} // namespace day12
@@ -0,0 +1,8 @@
+#include "day12.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day12::part1, day12::part2);
+}
@@ -1,41 +1,40 @@
+#include "day13.h"
+
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
 #include "utils.h"
 #include <QDebug>
-#include <QFile>
 #include <QString>
-#include <QTextStream>
 #include <QVector>
 
+#include <algorithm>
+#include <ranges>
+#include <string_view>
+
 namespace day13 {
 
 int countDifferentChars(const QString &s1, const QString &s2)
 {
-    auto data = utils::zip(s1, s2);
-    return std::accumulate(data.begin(), data.end(), 0, [](int sum, const auto &entry) {
-        return sum + (std::get<0>(entry) != std::get<1>(entry));
-    });
+    return static_cast<int>(std::ranges::count_if(utils::zip(s1, s2), [](const auto &entry) {
+        return entry.first != entry.second;
+    }));
 }
 
 int findMirror(const QVector<QString> &grid, bool findSmudges)
 {
     for (int i = 1; i < grid.size(); i++) {
-        auto above = grid.mid(0, i);
-        std::reverse(above.begin(), above.end());
-        auto below = grid.mid(i);
-        auto data  = utils::zip(above, below);
+        // rows above the mirror line, nearest first, next to the rows below it
+        auto data = utils::zip(grid | std::views::take(i) | std::views::reverse, grid | std::views::drop(i));
 
         if (findSmudges) {
-            if (std::accumulate(data.begin(),
-                                data.end(),
-                                0,
-                                [](int sum, const auto &entry) {
-                                    return sum + countDifferentChars(std::get<0>(entry), std::get<1>(entry));
-                                })
-                == 1)
+            int differences = 0;
+            for (const auto &[above, below] : data)
+                differences += countDifferentChars(above, below);
+            if (differences == 1)
                 return i;
         } else {
-            if (std::all_of(data.begin(), data.end(), [](const auto &entry) {
-                    return std::get<0>(entry) == std::get<1>(entry);
-                }))
+            if (std::ranges::all_of(data, [](const auto &entry) { return entry.first == entry.second; }))
                 return i;
         }
     }
@@ -47,40 +46,45 @@ struct Map
     QVector<QString> rows;
     QVector<QString> columns;
 
-    static Map parse(QTextStream &stream)
+    void appendRow(std::string_view line)
     {
-        Map map;
-        while (!stream.atEnd()) {
-            const QString line = stream.readLine().trimmed();
-            if (line.isEmpty())
-                break;
-            map.rows.append(line);
-            for (int i = 0; i < line.size(); ++i) {
-                if (map.columns.size() <= i)
-                    map.columns.append("");
-                map.columns[i].append(line[i]);
-            }
+        rows.append(utils::toQString(line));
+        for (std::size_t i = 0; i < line.size(); ++i) {
+            if (columns.size() <= static_cast<qsizetype>(i))
+                columns.append("");
+            columns[i].append(QChar::fromLatin1(line[i]));
         }
-        return map;
     }
 };
 
 QVector<Map> parse(const QString &fileName)
 {
-    QVector<Map> maps;
-    QFile        file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    QVector<Map>             maps;
+    const utils::MappedInput input(fileName);
+    if (!input.isOpen())
         return maps;
-    QTextStream stream(&file);
-    while (!stream.atEnd())
-        maps.append(Map::parse(stream));
+
+    Map map;
+    for (const auto rawLine : input.lines()) {
+        const auto line = utils::trimmed(rawLine);
+        if (line.empty()) {
+            maps.append(map);
+            map = {};
+            continue;
+        }
+        map.appendRow(line);
+    }
+    if (!map.rows.isEmpty())
+        maps.append(map);
     return maps;
 }
 
 QString part1(const QString &fileName)
 {
-    const auto maps = parse(fileName);
-    qint64     sum  = 0;
+    utils::PhaseProbe probe("parse");
+    const auto        maps = parse(fileName);
+    probe.next("solve");
+    qint64 sum = 0;
 
     for (const auto &map : maps) {
         sum += findMirror(map.rows, false) * 100;
@@ -92,8 +96,10 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    const auto maps = parse(fileName);
-    qint64     sum  = 0;
+    utils::PhaseProbe probe("parse");
+    const auto        maps = parse(fileName);
+    probe.next("solve");
+    qint64 sum = 0;
 
     for (const auto &map : maps) {
         sum += findMirror(map.rows, true) * 100;
@@ -104,9 +110,3 @@ QString part2(const QString &fileName)
 }
 
 } // namespace day13
-
-int main()
-{
-    qDebug() << "Part 1: " << day13::part1(":/input.txt");
-    qDebug() << "Part 2: " << day13::part2(":/input.txt");
-}
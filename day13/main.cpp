@@ -0,0 +1,8 @@
+#include "day13.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day13::part1, day13::part2);
+}
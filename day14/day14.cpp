@@ -1,18 +1,22 @@
+#include "day14.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
-#include "utils.h"
+#include "grid.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
+
+#include <algorithm>
+#include <numeric>
 
 namespace day14 {
 
 enum class Direction { North, East, South, West };
 
-struct Position
-{
-    int x = 0, y = 0;
-};
+using Position = utils::Point;
 
 void sortByDirection(Direction direction, QVector<Position> &positions)
 {
@@ -34,27 +38,21 @@ void sortByDirection(Direction direction, QVector<Position> &positions)
 
 struct Platform
 {
-    QVector<QVector<QChar>> grid;
-    QVector<Position>       roundedRocks;
+    // surrounded by a ring of cube rocks that stops every tilt
+    utils::Grid<char> grid;
+    QVector<Position> roundedRocks;
 
     static Platform parse(const QString &fileName)
     {
-        Platform platform;
-        QFile    file(fileName);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        Platform                 platform;
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
             return platform;
-        for (std::size_t y = 0; !file.atEnd(); y++) {
-            const QString line = file.readLine().trimmed();
-            if (line.isEmpty())
-                continue;
-
-            QVector<QChar> row;
-            for (const auto [x, c] : utils::enumerate(line)) {
-                if (c == 'O')
-                    platform.roundedRocks.append({static_cast<int>(x), static_cast<int>(y)});
-                row.append(c);
-            }
-            platform.grid.append(row);
+
+        platform.grid = utils::Grid<char>::fromLines(input.lines(), [](char c) { return c; }, 1, '#');
+        for (const auto position : platform.grid.points()) {
+            if (platform.grid[position] == 'O')
+                platform.roundedRocks.append(position);
         }
         return platform;
     }
@@ -67,27 +65,27 @@ struct Platform
             int x = roundedRock.x, y = roundedRock.y;
             switch (direction) {
             case Direction::North:
-                while (y >= 1 && grid[y - 1][x] == '.')
+                while (grid[{x, y - 1}] == '.')
                     y--;
                 break;
             case Direction::South:
-                while ((y + 1) < grid.size() && grid[y + 1][x] == '.')
+                while (grid[{x, y + 1}] == '.')
                     y++;
                 break;
             case Direction::East:
-                while ((x + 1) < grid[y].size() && grid[y][x + 1] == '.')
+                while (grid[{x + 1, y}] == '.')
                     x++;
                 break;
             case Direction::West:
-                while (x >= 1 && grid[y][x - 1] == '.')
+                while (grid[{x - 1, y}] == '.')
                     x--;
                 break;
             }
 
-            grid[roundedRock.y][roundedRock.x] = '.';
-            grid[y][x]                         = 'O';
-            roundedRock.x                      = x;
-            roundedRock.y                      = y;
+            grid[roundedRock] = '.';
+            grid[{x, y}]      = 'O';
+            roundedRock.x     = x;
+            roundedRock.y     = y;
         }
     }
 
@@ -96,20 +94,24 @@ struct Platform
 
 QString part1(const QString &fileName)
 {
-    auto platform = Platform::parse(fileName);
+    utils::PhaseProbe probe("parse");
+    auto              platform = Platform::parse(fileName);
+    probe.next("solve");
     platform.tilt(Direction::North);
     const int sum = std::accumulate(platform.roundedRocks.begin(),
                                     platform.roundedRocks.end(),
                                     0,
                                     [&platform](int sum, const auto &roundedRock) {
-                                        return sum + (platform.grid.size() - roundedRock.y);
+                                        return sum + (platform.grid.height() - roundedRock.y);
                                     });
     return QString::number(sum);
 }
 
 QString part2(const QString &fileName)
 {
+    utils::PhaseProbe probe("parse");
     auto              platform = Platform::parse(fileName);
+    probe.next("solve");
     QVector<Platform> visited;
 
     int steps = 0;
@@ -130,15 +132,9 @@ QString part2(const QString &fileName)
                                     platform.roundedRocks.end(),
                                     0,
                                     [&platform](int sum, const auto &roundedRock) {
-                                        return sum + (platform.grid.size() - roundedRock.y);
+                                        return sum + (platform.grid.height() - roundedRock.y);
                                     });
     return QString::number(sum);
 }
 
 } // namespace day14
-
-int main()
-{
-    qDebug() << "Part 1: " << day14::part1(":/input.txt");
-    qDebug() << "Part 2: " << day14::part2(":/input.txt");
-}
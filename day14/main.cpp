@@ -0,0 +1,8 @@
+#include "day14.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day14::part1, day14::part2);
+}
@@ -1,31 +1,37 @@
+#include "day15.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
+#include <numeric>
+#include <string_view>
 #include <utility>
 
+#include "mappedinput.h"
+#include "probes.h"
+#include "stringutils.h"
 #include "utils.h"
 
 namespace day15 {
 
-int checksum(const QString &input)
+int checksum(std::string_view input)
 {
     int result = 0;
     for (const auto c : input)
-        result = ((result + c.unicode()) * 17) % 256;
+        result = ((result + static_cast<unsigned char>(c)) * 17) % 256;
     return result;
 }
 
 struct HashMapData
 {
-    QString label;
-    int     focusPower = 0;
+    std::string_view label; // view into the input
+    int              focusPower = 0;
 };
 
 using HashMap = QVector<QVector<HashMapData>>;
 
-int findLabel(HashMap &map, const QString &label)
+int findLabel(HashMap &map, std::string_view label)
 {
     const int c = checksum(label);
     for (int i = 0; i < map[c].size(); i++) {
@@ -44,60 +50,60 @@ void insert(HashMap &map, const HashMapData &data)
         map[c][index] = data;
 }
 
-void remove(HashMap &map, const QString &label)
+void remove(HashMap &map, std::string_view label)
 {
     const int c = checksum(label);
     if (const int index = findLabel(map, label); index != -1)
         map[c].remove(index);
 }
 
-QStringList parse(const QString &fileName)
+// the words of the first line, as views into the input
+QVector<std::string_view> parse(const utils::MappedInput &input)
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-        return {};
-    const QString line = file.readLine().trimmed();
-    return line.split(',');
+    QVector<std::string_view> words;
+    if (const auto lines = input.lines(); !lines.empty()) {
+        for (const auto word : utils::split(utils::trimmed(lines.front()), ','))
+            words.append(word);
+    }
+    return words;
 }
 
 QString part1(const QString &fileName)
 {
-    auto input = parse(fileName);
-    return QString::number(std::accumulate(input.begin(), input.end(), 0, [](const int sum, const QString &word) {
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    const auto               words = parse(input);
+    probe.next("solve");
+    return QString::number(std::accumulate(words.begin(), words.end(), 0, [](const int sum, std::string_view word) {
         return sum + checksum(word);
     }));
 }
 
 QString part2(const QString &fileName)
 {
-    auto    input = parse(fileName);
+    utils::PhaseProbe        probe("parse");
+    const utils::MappedInput input(fileName);
+    const auto               words = parse(input);
+    probe.next("solve");
     HashMap map;
     map.resize(256);
-    for (auto &word : input) {
-        if (word.contains('=')) {
-            if (const auto parts = word.split('='); parts.size() == 2) {
-                const auto label = parts[0].trimmed();
-                const auto value = parts[1].trimmed().toInt();
-                insert(map, {label, value});
-            }
-        } else if (word.endsWith('-')) {
-            remove(map, word.left(word.size() - 1));
+    for (const auto word : words) {
+        if (const auto equals = word.find('='); equals != std::string_view::npos) {
+            const auto label = utils::trimmed(word.substr(0, equals));
+            const auto value = utils::toNumber<int>(word.substr(equals + 1));
+            insert(map, {label, value});
+        } else if (word.ends_with('-')) {
+            remove(map, word.substr(0, word.size() - 1));
         }
     }
 
-    std::size_t sum = 0;
-    for (const auto &[hash, data] : utils::enumerate(map)) {
-        for (auto const &[index, data] : utils::enumerate(data)) {
-            sum += (hash + 1) * (index + 1) * data.focusPower;
+    qint64 sum = 0;
+    for (const auto &[hash, box] : utils::enumerate(map)) {
+        for (const auto &[slot, lens] : utils::enumerate(box)) {
+            sum += (hash + 1) * (slot + 1) * lens.focusPower;
         }
     }
 
     return QString::number(sum);
 }
 } // namespace day15
-
-int main()
-{
-    qDebug() << "Part 1: " << day15::part1(":/input.txt");
-    qDebug() << "Part 2: " << day15::part2(":/input.txt");
-}
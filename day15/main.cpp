@@ -0,0 +1,8 @@
+#include "day15.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day15::part1, day15::part2);
+}
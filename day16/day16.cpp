@@ -1,10 +1,24 @@
+#include "day16.h"
+
+#include "arena.h"
+#include "grid.h"
+#include "lookuptable.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "smallvector.h"
+#include "stringutils.h"
+#include "taskpool.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QObject>
 #include <QString>
 #include <QVector>
 
+#include <algorithm>
+#include <optional>
 #include <ranges>
+#include <utility>
+#include <vector>
 
 namespace day16 {
 
@@ -41,51 +55,68 @@ struct Beam
 
 struct Field
 {
-    QChar              c;
-    int                visited = 0;
-    QVector<Direction> handledDirections;
+    QChar c;
+    int   visited = 0;
+    // a beam enters a field in at most four directions, kept inline so that
+    // recording one does not allocate
+    utils::SmallVector<Direction, 4> handledDirections;
+
+    Field() = default;
+
+    explicit Field(QChar c)
+        : c(c)
+    {}
 };
 
 std::optional<Beam> handleFieldAction(QChar c, Beam &beam)
 {
-    struct Key
-    {
-        QChar     c;
-        Direction d;
-
-        bool operator<(const Key &other) const { return std::tie(c, d) < std::tie(other.c, other.d); }
-    };
-
     struct Value
     {
         Direction           d = Direction::Right;
         std::optional<Beam> b;
     };
 
-    static const QMap<Key, Value> map{
-        {{'|', Direction::Right},  {Direction::Up, Beam{.direction = Direction::Down}}   },
-        {{'|', Direction::Left},   {Direction::Up, Beam{.direction = Direction::Down}}   },
-        {{'|', Direction::Up},     {Direction::Up, {}}                                   },
-        {{'|', Direction::Down},   {Direction::Down, {}}                                 },
-        {{'-', Direction::Up},     {Direction::Left, Beam{.direction = Direction::Right}}},
-        {{'-', Direction::Down},   {Direction::Left, Beam{.direction = Direction::Right}}},
-        {{'-', Direction::Left},   {Direction::Left, {}}                                 },
-        {{'-', Direction::Right},  {Direction::Right, {}}                                },
-        {{'/', Direction::Up},     {Direction::Right, {}}                                },
-        {{'/', Direction::Down},   {Direction::Left, {}}                                 },
-        {{'/', Direction::Left},   {Direction::Down, {}}                                 },
-        {{'/', Direction::Right},  {Direction::Up, {}}                                   },
-        {{'\\', Direction::Up},    {Direction::Left, {}}                                 },
-        {{'\\', Direction::Down},  {Direction::Right, {}}                                },
-        {{'\\', Direction::Left},  {Direction::Up, {}}                                   },
-        {{'\\', Direction::Right}, {Direction::Down, {}}                                 },
-        {{'.', Direction::Up},     {Direction::Up, {}}                                   },
-        {{'.', Direction::Down},   {Direction::Down, {}}                                 },
-        {{'.', Direction::Left},   {Direction::Left, {}}                                 },
-        {{'.', Direction::Right},  {Direction::Right, {}}                                },
+    // per field the outcome for every direction, unknown fields turn beams right
+    using Outcomes = utils::LookupTable<Direction, Value, 4>;
+    static constexpr utils::LookupTable<char, Outcomes> table{
+        {'|',
+         {
+             {Direction::Right, {Direction::Up, Beam{.direction = Direction::Down}}},
+             {Direction::Left, {Direction::Up, Beam{.direction = Direction::Down}}},
+             {Direction::Up, {Direction::Up, {}}},
+             {Direction::Down, {Direction::Down, {}}},
+         }},
+        {'-',
+         {
+             {Direction::Up, {Direction::Left, Beam{.direction = Direction::Right}}},
+             {Direction::Down, {Direction::Left, Beam{.direction = Direction::Right}}},
+             {Direction::Left, {Direction::Left, {}}},
+             {Direction::Right, {Direction::Right, {}}},
+         }},
+        {'/',
+         {
+             {Direction::Up, {Direction::Right, {}}},
+             {Direction::Down, {Direction::Left, {}}},
+             {Direction::Left, {Direction::Down, {}}},
+             {Direction::Right, {Direction::Up, {}}},
+         }},
+        {'\\',
+         {
+             {Direction::Up, {Direction::Left, {}}},
+             {Direction::Down, {Direction::Right, {}}},
+             {Direction::Left, {Direction::Up, {}}},
+             {Direction::Right, {Direction::Down, {}}},
+         }},
+        {'.',
+         {
+             {Direction::Up, {Direction::Up, {}}},
+             {Direction::Down, {Direction::Down, {}}},
+             {Direction::Left, {Direction::Left, {}}},
+             {Direction::Right, {Direction::Right, {}}},
+         }},
     };
 
-    auto res = map.value({c, beam.direction});
+    auto res = table[c.toLatin1()][beam.direction];
     if (res.b) {
         res.b->x = beam.x;
         res.b->y = beam.y;
@@ -96,32 +127,32 @@ std::optional<Beam> handleFieldAction(QChar c, Beam &beam)
 
 struct Map
 {
-    QVector<QVector<Field>> grid;
-    QVector<Beam>           beams;
+    // the grid and the per field state live in one arena
+    utils::Grid<Field> grid;
+    QVector<Beam>      beams;
 
-    static Map parse(const QString &fileName)
+    static Map parse(const QString &fileName, utils::ArenaAllocator allocator)
     {
-        Map   map;
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-            return map;
-        while (!file.atEnd()) {
-            const QString  line = file.readLine().trimmed();
-            QVector<Field> row;
-            for (const QChar c : line)
-                row.append({c});
-            map.grid.append(row);
-        }
-        return map;
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
+            return {};
+        return {
+            utils::Grid<Field>::fromLines(
+                input.lines(), [](char c) { return Field(QChar::fromLatin1(c)); }, 0, Field(), allocator),
+            {},
+        };
     }
 
-    [[nodiscard]] bool isOnMap(int x, int y) const { return x >= 0 && y >= 0 && x < grid[0].size() && y < grid.size(); }
+    // deep copy of the map whose grid is allocated from allocator
+    [[nodiscard]] Map copy(utils::ArenaAllocator allocator) const { return {utils::Grid<Field>(grid, allocator), beams}; }
+
+    [[nodiscard]] bool isOnMap(int x, int y) const { return grid.contains({x, y}); }
 
     void moveUntilCollision()
     {
         for (auto &b : beams) {
-            while (isOnMap(b.x, b.y) && grid[b.y][b.x].c == '.') {
-                grid[b.y][b.x].visited++;
+            while (isOnMap(b.x, b.y) && grid[{b.x, b.y}].c == '.') {
+                grid[{b.x, b.y}].visited++;
                 b.move();
             }
         }
@@ -135,8 +166,8 @@ struct Map
 
         QVector<Beam> beamsToAdd;
         for (auto &b : beams) {
-            grid[b.y][b.x].visited++;
-            if (auto res = handleFieldAction(grid[b.y][b.x].c, b))
+            grid[{b.x, b.y}].visited++;
+            if (auto res = handleFieldAction(grid[{b.x, b.y}].c, b))
                 beamsToAdd.append(*res);
         }
         beams.append(beamsToAdd);
@@ -144,25 +175,22 @@ struct Map
         // remove beams that were already handled
         beams.erase(std::ranges::remove_if(beams,
                                            [this](const Beam &b) {
-                                               return grid[b.y][b.x].handledDirections.contains(b.direction);
+                                               const auto &handled = grid[{b.x, b.y}].handledDirections;
+                                               return std::ranges::find(handled, b.direction) != handled.end();
                                            })
                         .begin(),
                     beams.end());
 
         std::ranges::for_each(beams, [this](Beam &b) {
-            grid[b.y][b.x].handledDirections.append(b.direction);
+            grid[{b.x, b.y}].handledDirections.push_back(b.direction);
             b.move();
         });
     }
 
     [[nodiscard]] int visitedTiles() const
     {
-        int sum = 0;
-        for (const auto &row : grid)
-            for (const auto &field : row)
-                if (field.visited > 0)
-                    sum++;
-        return sum;
+        return static_cast<int>(
+            std::ranges::count_if(grid.points(), [this](utils::Point p) { return grid[p].visited > 0; }));
     }
 
     void exec()
@@ -174,9 +202,17 @@ struct Map
     }
 };
 
+// start beams per task of part 2
+constexpr std::size_t beamGrainSize = 4;
+
+namespace reference {
+
 QString part1(const QString &fileName)
 {
-    auto map = Map::parse(fileName);
+    utils::PhaseProbe probe("parse");
+    utils::Arena      arena;
+    auto              map = Map::parse(fileName, arena.allocator());
+    probe.next("solve");
     map.beams.append({0, 0, Direction::Right});
     map.exec();
     return QString::number(map.visitedTiles());
@@ -184,10 +220,13 @@ QString part1(const QString &fileName)
 
 QString part2(const QString &fileName)
 {
-    const auto initMap = Map::parse(fileName);
-    const int  rows    = initMap.grid.size();
-    const int  cols    = initMap.grid[0].size();
+    utils::PhaseProbe probe("parse");
+    utils::Arena      arena;
+    const auto        initMap = Map::parse(fileName, arena.allocator());
+    const int         rows    = initMap.grid.height();
+    const int         cols    = initMap.grid.width();
 
+    probe.next("solve");
     QVector<Beam> startBeams;
     for (int y = 0; y < rows; y++)
         startBeams.append({0, y, Direction::Right});
@@ -198,23 +237,187 @@ QString part2(const QString &fileName)
     for (int x = 0; x < cols; x++)
         startBeams.append({x, rows - 1, Direction::Up});
 
-    int result = 0;
-    for (auto startBeam : startBeams) {
-        auto map = initMap;
-        map.beams.append(startBeam);
-        map.exec();
-        result = std::max(result, map.visitedTiles());
-    }
+    // The start beams are independent and run as parallel tasks. Every beam
+    // runs on its own copy of the map; each task rewinds its arena for every
+    // beam, so that the copies reuse the same memory.
+    std::vector<int> visited(static_cast<std::size_t>(startBeams.size()), 0);
+    const auto       runBeams = [&](std::size_t first, std::size_t last) {
+        utils::Arena beamArena(sizeof(Field) * rows * cols);
+        for (auto i = first; i < last; ++i) {
+            beamArena.release();
+            auto map = initMap.copy(beamArena.allocator());
+            map.beams.append(startBeams.at(static_cast<qsizetype>(i)));
+            map.exec();
+            visited[i] = map.visitedTiles();
+        }
+    };
+    utils::parallelFor(0, visited.size(), beamGrainSize, runBeams);
+    const auto result = visited.empty() ? 0 : std::ranges::max(visited);
 
     return QString::number(result);
 }
 
-} // namespace day16
+} // namespace reference
 
-int main()
+// Direction a beam leaves a cell in and the direction of the beam that is split
+// off, if any. Unknown cells turn beams right, as in the reference solution.
+using Deflection = std::pair<Direction, std::optional<Direction>>;
+
+constexpr Deflection deflect(char c, Direction d)
 {
-    qDebug() << "Part 1: " << day16::part1(":/input.txt");
-    qDebug() << "Part 2: " << day16::part2(":/input.txt");
+    const bool vertical = d == Direction::Up || d == Direction::Down;
+    switch (c) {
+    case '.':
+        return {d, {}};
+    case '|':
+        if (vertical)
+            return {d, {}};
+        return {Direction::Up, Direction::Down};
+    case '-':
+        if (!vertical)
+            return {d, {}};
+        return {Direction::Left, Direction::Right};
+    case '/':
+        switch (d) {
+        case Direction::Up:
+            return {Direction::Right, {}};
+        case Direction::Down:
+            return {Direction::Left, {}};
+        case Direction::Left:
+            return {Direction::Down, {}};
+        case Direction::Right:
+            return {Direction::Up, {}};
+        }
+        break;
+    case '\\':
+        switch (d) {
+        case Direction::Up:
+            return {Direction::Left, {}};
+        case Direction::Down:
+            return {Direction::Right, {}};
+        case Direction::Left:
+            return {Direction::Up, {}};
+        case Direction::Right:
+            return {Direction::Down, {}};
+        }
+        break;
+    }
+    return {Direction::Right, {}};
 }
 
-#include "day16.moc"
\ No newline at end of file
+// deflect() for every cell and direction, so that a beam step is one lookup
+// instead of branching on both
+constexpr auto deflections = [] {
+    using Outcomes = utils::LookupTable<Direction, Deflection, 4>;
+    utils::LookupTable<char, Outcomes> table(Outcomes(Deflection{Direction::Right, {}}));
+    for (const char c : {'.', '|', '-', '/', '\\'}) {
+        Outcomes outcomes;
+        for (const auto d : {Direction::Up, Direction::Down, Direction::Left, Direction::Right})
+            outcomes.insert(d, deflect(c, d));
+        table.insert(c, outcomes);
+    }
+    return table;
+}();
+
+// Follows the beams with a stack instead of stepping all of them in lockstep.
+// A cell remembers the directions beams entered it in as bits, a beam that
+// enters a cell in a known direction repeats an earlier path and is dropped.
+class Contraption
+{
+public:
+    explicit Contraption(utils::Grid<char> grid)
+        : _grid(std::move(grid))
+    {}
+
+    static Contraption parse(const QString &fileName)
+    {
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
+            return Contraption({});
+        return Contraption(utils::Grid<char>::fromLines(input.lines(), [](char c) { return c; }));
+    }
+
+    [[nodiscard]] int width() const { return _grid.width(); }
+
+    [[nodiscard]] int height() const { return _grid.height(); }
+
+    // number of cells the beam starting at start energizes, entered is
+    // scratch space that is reused between calls
+    int energize(Beam start, std::vector<quint8> &entered, std::vector<Beam> &pending) const
+    {
+        entered.assign(static_cast<std::size_t>(width()) * static_cast<std::size_t>(height()), 0);
+        pending.assign(1, start);
+
+        int energized = 0;
+        while (!pending.empty()) {
+            auto beam = pending.back();
+            pending.pop_back();
+            while (_grid.contains({beam.x, beam.y})) {
+                auto      &cell = entered[static_cast<std::size_t>(beam.y) * width() + beam.x];
+                const auto bit  = static_cast<quint8>(1u << static_cast<int>(beam.direction));
+                if (cell & bit)
+                    break;
+                if (cell == 0)
+                    energized++;
+                cell |= bit;
+
+                const auto [direction, split] = deflections[_grid[{beam.x, beam.y}]][beam.direction];
+                if (split) {
+                    Beam splitBeam{beam.x, beam.y, *split};
+                    splitBeam.move();
+                    pending.push_back(splitBeam);
+                }
+                beam.direction = direction;
+                beam.move();
+            }
+        }
+        return energized;
+    }
+
+private:
+    utils::Grid<char> _grid;
+};
+
+QString part1(const QString &fileName)
+{
+    utils::PhaseProbe   probe("parse");
+    const auto          contraption = Contraption::parse(fileName);
+    std::vector<quint8> entered;
+    std::vector<Beam>   pending;
+    probe.next("solve");
+    return QString::number(contraption.energize({0, 0, Direction::Right}, entered, pending));
+}
+
+QString part2(const QString &fileName)
+{
+    utils::PhaseProbe probe("parse");
+    const auto        contraption = Contraption::parse(fileName);
+    const int         rows        = contraption.height();
+    const int         cols        = contraption.width();
+
+    probe.next("solve");
+    QVector<Beam> startBeams;
+    for (int y = 0; y < rows; y++)
+        startBeams.append({0, y, Direction::Right});
+    for (int y = 0; y < rows; y++)
+        startBeams.append({cols - 1, y, Direction::Left});
+    for (int x = 0; x < cols; x++)
+        startBeams.append({x, 0, Direction::Down});
+    for (int x = 0; x < cols; x++)
+        startBeams.append({x, rows - 1, Direction::Up});
+
+    std::vector<int> energized(static_cast<std::size_t>(startBeams.size()), 0);
+    utils::parallelFor(0, energized.size(), beamGrainSize, [&](std::size_t first, std::size_t last) {
+        std::vector<quint8> entered;
+        std::vector<Beam>   pending;
+        for (auto i = first; i < last; ++i)
+            energized[i] = contraption.energize(startBeams.at(static_cast<qsizetype>(i)), entered, pending);
+    });
+    const auto result = energized.empty() ? 0 : std::ranges::max(energized);
+
+    return QString::number(result);
+}
+
+} // namespace day16
+
+#include "day16.moc"
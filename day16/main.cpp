@@ -0,0 +1,8 @@
+#include "day16.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day16::part1, day16::part2);
+}
@@ -1,5 +1,12 @@
+#include "day17.h"
+
+#include "grid.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "smallvector.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
@@ -10,25 +17,14 @@ namespace day17 {
 
 struct Map
 {
-    QVector<QVector<int>> grid;
+    utils::Grid<int> grid;
 
     static Map parse(const QString &fileName)
     {
-        Map   map;
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-            return map;
-        while (!file.atEnd()) {
-            const QString line = file.readLine().trimmed();
-            if (line.isEmpty())
-                continue;
-
-            QVector<int> row;
-            for (const auto &c : line)
-                row.append(static_cast<int>(c.unicode() - '0'));
-            map.grid.append(row);
-        }
-        return map;
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
+            return {};
+        return {utils::Grid<int>::fromLines(input.lines(), [](char c) { return static_cast<int>(c - '0'); })};
     }
 };
 
@@ -58,7 +54,7 @@ struct Cell
     bool operator>(const Cell &other) const { return this->dist > other.dist; }
 };
 
-QVector<Direction> validDirections(Direction dir)
+utils::SmallVector<Direction, 4> validDirections(Direction dir)
 {
     switch (dir) {
     case Direction::Left:
@@ -75,12 +71,13 @@ QVector<Direction> validDirections(Direction dir)
     return {Direction::Left, Direction::Right, Direction::Up, Direction::Down};
 }
 
-QVector<Cell> validNeighbors(const Position              &pos,
-                             const QVector<QVector<int>> &grid,
-                             qsizetype                    minStraights,
-                             qsizetype                    maxStraights)
+// at most one neighbor per direction, kept inline so that no step allocates
+utils::SmallVector<Cell, 4> validNeighbors(const Position         &pos,
+                                           const utils::Grid<int> &grid,
+                                           qsizetype               minStraights,
+                                           qsizetype               maxStraights)
 {
-    QVector<Cell> neighbors;
+    utils::SmallVector<Cell, 4> neighbors;
     for (const auto &dir : validDirections(pos.direction)) {
         if (pos.direction == dir && pos.straights >= maxStraights)
             continue;
@@ -88,18 +85,22 @@ QVector<Cell> validNeighbors(const Position              &pos,
             continue;
         const auto newX = pos.x + (dir == Direction::Left ? -1 : dir == Direction::Right ? 1 : 0);
         const auto newY = pos.y + (dir == Direction::Up ? -1 : dir == Direction::Down ? 1 : 0);
-        if (newX < 0 || newY < 0 || newY >= grid.size() || newX >= grid[0].size())
+        const auto next = utils::Point{static_cast<int>(newX), static_cast<int>(newY)};
+        if (!grid.contains(next))
             continue;
-        neighbors.append(Cell{
+        neighbors.push_back(Cell{
             Position{newX, newY, dir, dir == pos.direction ? pos.straights + 1 : 1},
-            grid[newY][newX],
+            grid[next],
         });
     }
     return neighbors;
 }
 
-qsizetype dijkstra(
-    QVector<QVector<int>> &grid, Position source, Position destination, qsizetype minStraights, qsizetype maxStraights)
+qsizetype dijkstra(const utils::Grid<int> &grid,
+                   Position                source,
+                   Position                destination,
+                   qsizetype               minStraights,
+                   qsizetype               maxStraights)
 {
     std::priority_queue<Cell, QVector<Cell>, std::greater<>> pq;
     pq.push({source, 0});
@@ -127,20 +128,18 @@ qsizetype dijkstra(
 
 QString part1(const QString &fileName)
 {
-    auto map = Map::parse(fileName);
-    return QString::number(dijkstra(map.grid, {0, 0}, {map.grid[0].size() - 1, map.grid.size() - 1}, 1, 3));
+    utils::PhaseProbe probe("parse");
+    auto              map = Map::parse(fileName);
+    probe.next("solve");
+    return QString::number(dijkstra(map.grid, {0, 0}, {map.grid.width() - 1, map.grid.height() - 1}, 1, 3));
 }
 
 QString part2(const QString &fileName)
 {
-    auto map = Map::parse(fileName);
-    return QString::number(dijkstra(map.grid, {0, 0}, {map.grid[0].size() - 1, map.grid.size() - 1}, 4, 10));
+    utils::PhaseProbe probe("parse");
+    auto              map = Map::parse(fileName);
+    probe.next("solve");
+    return QString::number(dijkstra(map.grid, {0, 0}, {map.grid.width() - 1, map.grid.height() - 1}, 4, 10));
 }
 
 } // namespace day17
-
-int main()
-{
-    qDebug() << "Part 1: " << day17::part1(":/input.txt");
-    qDebug() << "Part 2: " << day17::part2(":/input.txt");
-}
@@ -0,0 +1,8 @@
+#include "day17.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day17::part1, day17::part2);
+}
@@ -1,7 +1,16 @@
+#include "day18.h"
+
+#include "linereader.h"
+#include "lookuptable.h"
+#include "probes.h"
+#include "stringutils.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
 
+#include <optional>
+#include <string_view>
+
 namespace day18 {
 
 enum class Direction { Right, Down, Left, Up };
@@ -18,16 +27,16 @@ struct Point
     Point operator*(const qint64 &m) const { return Point{x * m, y * m}; }
 };
 
-static QMap<Direction, Point> motions{
+constexpr utils::LookupTable<Direction, Point, 4> motions{
     {Direction::Right, {1, 0} },
     {Direction::Down,  {0, 1} },
     {Direction::Left,  {-1, 0}},
     {Direction::Up,    {0, -1}},
 };
 
-Direction parseDirection(const QChar &c)
+Direction parseDirection(char c)
 {
-    switch (c.unicode()) {
+    switch (c) {
     case 'U':
         return Direction::Up;
     case 'D':
@@ -47,46 +56,43 @@ struct Rule
     qint64    steps = 0;
 };
 
-using Rules = QVector<Rule>;
-
-Rules parseRules(const QString &fileName, bool part2 = false)
+std::optional<Rule> parseRule(std::string_view line, bool part2)
 {
-    Rules rules;
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    line = utils::trimmed(line);
+    if (line.empty())
         return {};
-    while (!file.atEnd()) {
-        const QString line = file.readLine().trimmed();
-        if (line.isEmpty())
-            continue;
-        const auto parts = line.split(' ');
-
-        if (part2) {
-            const auto color     = parts.value(2).removeLast().remove(0, 2).toUInt(nullptr, 16);
-            const auto direction = static_cast<Direction>(color & 0xf);
-            const auto steps     = (color >> 4) & 0xfffff;
-            rules.append({direction, static_cast<qint64>(steps)});
-        } else {
-            rules.append({parseDirection(parts.at(0).at(0)), parts.at(1).toInt()});
-        }
+    const auto [direction, steps, color] = utils::splitFixed<3>(line, ' ');
+
+    if (part2) {
+        // "(#70c710)"
+        const auto code = utils::toNumber<quint32>(color.substr(2, color.size() - 3), 16);
+        return Rule{static_cast<Direction>(code & 0xf), static_cast<qint64>((code >> 4) & 0xfffff)};
     }
-    return rules;
+    return Rule{parseDirection(direction.front()), utils::toNumber<qint64>(steps)};
 }
 
 QString process(const QString &fileName, bool part2)
 {
-    // Green's theorem
-    const auto rules = parseRules(fileName, part2);
+    utils::PhaseProbe probe("parse");
+    utils::LineReader input(fileName);
+    if (!input.isOpen())
+        return {};
+
+    // Green's theorem, the rules are read and applied in one pass
+    probe.next("solve");
 
     qint64 perimeter = 0;
     qint64 area      = 0;
     Point  p{0, 0};
 
-    for (const auto &[direction, steps] : rules) {
-        const auto &motion = motions[direction];
-        auto        dp     = motion * steps;
-        p                  = p + dp;
-        perimeter += steps;
+    for (const auto line : input.lines()) {
+        const auto rule = parseRule(line, part2);
+        if (!rule)
+            continue;
+        const auto motion = motions[rule->direction];
+        auto       dp     = motion * rule->steps;
+        p                 = p + dp;
+        perimeter += rule->steps;
         area += p.x * dp.y;
     }
 
@@ -104,9 +110,3 @@ QString part2(const QString &fileName)
 }
 
 } // namespace day18
-
-int main()
-{
-    qDebug() << "Part 1: " << day18::part1(":/input.txt");
-    qDebug() << "Part 2: " << day18::part2(":/input.txt");
-}
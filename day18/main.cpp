@@ -0,0 +1,8 @@
+#include "day18.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day18::part1, day18::part2);
+}
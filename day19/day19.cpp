@@ -1,8 +1,22 @@
+#include "day19.h"
+
+#include "interner.h"
+#include "mappedinput.h"
+#include "probes.h"
+#include "snapshot.h"
+#include "stringutils.h"
+#include "taskpool.h"
+
 #include <QDebug>
-#include <QFile>
 #include <QString>
 #include <QVector>
 
+#include <array>
+#include <atomic>
+#include <numeric>
+#include <optional>
+#include <string_view>
+
 namespace day19 {
 
 enum class ResultType {
@@ -12,12 +26,21 @@ enum class ResultType {
     Jump,
 };
 
+// Workflow and category names are interned at parse time: jumps refer to the
+// target workflow by id and conditions to the category by id, both index
+// plain vectors.
+struct Names
+{
+    utils::Interner workflows;
+    utils::Interner categories;
+};
+
 struct Result
 {
-    ResultType type{ResultType::None};
-    QString    target; // target for jump
+    ResultType          type{ResultType::None};
+    utils::Interner::Id target = utils::Interner::invalid; // target workflow for jump
 
-    static Result parse(const QString &line)
+    static Result parse(std::string_view line, Names &names)
     {
         Result result;
         if (line == "A") {
@@ -26,7 +49,7 @@ struct Result
             result.type = ResultType::Rejected;
         } else {
             result.type   = ResultType::Jump;
-            result.target = line;
+            result.target = names.workflows.intern(line);
         }
         return result;
     }
@@ -39,103 +62,101 @@ enum class ConditionType {
     True,
 };
 
-struct Condition
+// a rating per category id, a part may lack some of the categories
+struct RatingList
 {
-    ConditionType type{ConditionType::None};
-    QString       varName;
-    qint64        number = 0;
-    Result        result;
+    QVector<std::optional<qint64>> values;
+    qint64                         sum = 0;
 
-    static Condition parse(const QString &line)
+    template<typename Archive>
+    void serialize(Archive &ar)
     {
-        Condition condition;
-        if (line.contains('<')) {
-            auto conRes         = line.split(':');
-            condition.type      = ConditionType::LowerThan;
-            const auto subParts = conRes.at(0).split('<');
-            condition.varName   = subParts[0];
-            condition.number    = subParts[1].toLongLong();
-            condition.result    = Result::parse(conRes.at(1));
-        } else if (line.contains('>')) {
-            auto conRes         = line.split(':');
-            condition.type      = ConditionType::GreaterThan;
-            const auto subParts = conRes.at(0).split('>');
-            condition.varName   = subParts[0];
-            condition.number    = subParts[1].toLongLong();
-            condition.result    = Result::parse(conRes.at(1));
-        } else {
-            condition.type   = ConditionType::True;
-            condition.result = Result::parse(line);
-        }
-        return condition;
+        ar(values, sum);
     }
 
-    [[nodiscard]] Result evaluate(const QString &name, const qint64 value) const
+    // "{x=787,m=2655,a=1222,s=2876}"
+    static RatingList parse(std::string_view line, Names &names)
     {
-        if (type == ConditionType::LowerThan) {
-            if (name == this->varName && value < this->number)
-                return result;
-        } else if (type == ConditionType::GreaterThan) {
-            if (name == this->varName && value > this->number)
-                return result;
-        } else if (type == ConditionType::True) {
-            return result;
+        const auto input = line.substr(1, line.find('}') - 1);
+        RatingList ratingList;
+        for (const auto rating : utils::split(input, ',')) {
+            const auto [name, value] = utils::splitFixed<2>(utils::trimmed(rating), '=');
+            const auto category      = names.categories.intern(utils::trimmed(name));
+            const auto number        = utils::toNumber<qint64>(value);
+            if (ratingList.values.size() <= category)
+                ratingList.values.resize(category + 1);
+            ratingList.values[category] = number;
+            ratingList.sum += number;
         }
-        return {};
+        return ratingList;
     }
-};
 
-struct Rating
-{
-    QString name;
-    qint64  value = 0;
-
-    static Rating parse(const QString &line)
+    [[nodiscard]] std::optional<qint64> value(utils::Interner::Id category) const
     {
-        Rating rating;
-        auto   parts = line.split('=');
-        rating.name  = parts[0].trimmed();
-        rating.value = parts[1].trimmed().toLongLong();
-        return rating;
+        return category < values.size() ? values[category] : std::nullopt;
     }
 };
 
-struct RatingList
+struct Condition
 {
-    QVector<Rating> ratings;
+    ConditionType       type{ConditionType::None};
+    utils::Interner::Id category = utils::Interner::invalid;
+    qint64              number   = 0;
+    Result              result;
 
-    static RatingList parse(const QString &line)
+    // "a<2006:qkq", "m>2090:A" or just "rfg"
+    static Condition parse(std::string_view line, Names &names)
     {
-        QString input = line;
-        input.remove('{');
-        input.remove('}');
-        RatingList ratingList;
-        for (const auto &rating : input.split(','))
-            ratingList.ratings.append(Rating::parse(rating.trimmed()));
-        return ratingList;
+        Condition condition;
+        if (const auto op = line.find_first_of("<>"); op != std::string_view::npos) {
+            const auto colon   = line.find(':', op);
+            condition.type     = line[op] == '<' ? ConditionType::LowerThan : ConditionType::GreaterThan;
+            condition.category = names.categories.intern(line.substr(0, op));
+            condition.number   = utils::toNumber<qint64>(line.substr(op + 1, colon - op - 1));
+            condition.result   = Result::parse(line.substr(colon + 1), names);
+        } else {
+            condition.type   = ConditionType::True;
+            condition.result = Result::parse(line, names);
+        }
+        return condition;
     }
 
-    [[nodiscard]] qint64 sumOfRatings() const
+    [[nodiscard]] bool matches(const RatingList &ratings) const
     {
-        return std::accumulate(ratings.begin(), ratings.end(), 0, [](const qint64 sum, const Rating &rating) {
-            return sum + rating.value;
-        });
+        if (type == ConditionType::True)
+            return true;
+        const auto value = ratings.value(category);
+        if (!value)
+            return false;
+        if (type == ConditionType::LowerThan)
+            return *value < number;
+        if (type == ConditionType::GreaterThan)
+            return *value > number;
+        return false;
     }
 };
 
 struct Workflow
 {
-    QString            name;
-    QVector<Condition> conditions;
-    Condition          def;
+    utils::Interner::Id id = utils::Interner::invalid;
+    QVector<Condition>  conditions;
+    Condition           def;
 
-    static Workflow parse(const QString &line)
+    template<typename Archive>
+    void serialize(Archive &ar)
     {
-        Workflow workflow;
-        auto     parts = line.split("{");
-        workflow.name  = parts[0].trimmed();
-        for (const auto &condition : parts[1].removeLast().split(','))
-            workflow.conditions.append(Condition::parse(condition.trimmed()));
+        ar(id, conditions, def);
+    }
+
+    // "px{a<2006:qkq,m>2090:A,rfg}"
+    static Workflow parse(std::string_view line, Names &names)
+    {
+        Workflow   workflow;
+        const auto open  = line.find('{');
+        const auto close = line.rfind('}');
+        workflow.id      = names.workflows.intern(utils::trimmed(line.substr(0, open)));
+        for (const auto condition : utils::split(line.substr(open + 1, close - open - 1), ','))
+            workflow.conditions.append(Condition::parse(utils::trimmed(condition), names));
         workflow.def = workflow.conditions.last();
         workflow.conditions.removeLast();
         return workflow;
@@ -144,59 +165,77 @@ struct Workflow
     [[nodiscard]] Result evaluate(const RatingList &ratings) const
     {
         for (const auto &condition : conditions) {
-            for (const auto &rating : ratings.ratings) {
-                if (rating.name == condition.varName) {
-                    auto result = condition.evaluate(rating.name, rating.value);
-                    if (result.type != ResultType::None)
-                        return result;
-                }
-            }
+            if (condition.matches(ratings))
+                return condition.result;
         }
         return def.result;
     }
 };
 
-using Workflows = QHash<QString, Workflow>;
+// the categories of part 2, interned first so that they always exist
+constexpr std::array<std::string_view, 4> categoryNames{"x", "m", "a", "s"};
 
 struct Process
 {
-    Workflows           workflows;
+    QVector<Workflow>   workflows; // indexed by id
     QVector<RatingList> ratings;
+    utils::Interner::Id in            = utils::Interner::invalid;
+    qsizetype           categoryCount = categoryNames.size(); // that the workflows use
+
+    // bump snapshotVersion when the serialized members of any part change
+    static constexpr quint32 snapshotVersion = 2;
+
+    template<typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(workflows, ratings, in, categoryCount);
+    }
 
     static Process parse(const QString &fileName)
+    {
+        const utils::MappedInput input(fileName);
+        if (!input.isOpen())
+            return {};
+        return utils::cachedParse<Process>("day19", snapshotVersion, input.data(), [&input] { return parse(input); });
+    }
+
+    static Process parse(const utils::MappedInput &input)
     {
         Process process;
-        QFile   file(fileName);
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-            return process;
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            const QString line = in.readLine().trimmed();
-            if (line.isEmpty())
+        Names   names;
+        for (const auto name : categoryNames)
+            names.categories.intern(name);
+        process.in = names.workflows.intern("in");
+
+        for (const auto rawLine : input.lines()) {
+            const auto line = utils::trimmed(rawLine);
+            if (line.empty())
                 continue;
-            if (line.startsWith("{")) {
-                process.ratings.append(RatingList::parse(line));
+            if (line.starts_with('{')) {
+                process.ratings.append(RatingList::parse(line, names));
             } else {
-                auto workflow = Workflow::parse(line);
-                process.workflows.insert(workflow.name, workflow);
+                auto workflow = Workflow::parse(line, names);
+                if (process.workflows.size() <= workflow.id)
+                    process.workflows.resize(workflow.id + 1);
+                process.workflows[workflow.id] = std::move(workflow);
+                process.categoryCount          = names.categories.size();
             }
         }
+        // jump targets that were never defined are empty workflows
+        process.workflows.resize(names.workflows.size());
         return process;
     }
 
     [[nodiscard]] qint64 evalRating(const RatingList &ratingList) const
     {
-        auto workflow = workflows.value("in");
+        auto workflow = in;
         while (true) {
-            auto evalResult = workflow.evaluate(ratingList);
-            if (evalResult.type == ResultType::Accepted) {
-                return ratingList.sumOfRatings();
+            auto evalResult = workflows[workflow].evaluate(ratingList);
+            if (evalResult.type == ResultType::Accepted)
+                return ratingList.sum;
+            if (evalResult.type != ResultType::Jump)
                 break;
-            } else if (evalResult.type == ResultType::Rejected) {
-                break;
-            } else if (evalResult.type == ResultType::Jump) {
-                workflow = workflows.value(evalResult.target);
-            }
+            workflow = evalResult.target;
         }
         return 0;
     }
@@ -217,7 +256,14 @@ struct Range
     [[nodiscard]] qint64 size() const { return max - min + 1; }
 };
 
-qint64 count(QHash<QString, Range> ranges, const Result &result, const Process &process)
+// accepted range per category id
+using Ranges = QVector<Range>;
+
+// the branches this close to the "in" workflow are counted as parallel tasks,
+// the ones further down are too small to be worth a task
+constexpr int forkDepth = 3;
+
+qint64 count(Ranges ranges, const Result &result, const Process &process, int depth = 0)
 {
     qint64 total = 0;
 
@@ -231,10 +277,16 @@ qint64 count(QHash<QString, Range> ranges, const Result &result, const Process &
         return product;
     }
 
-    auto workflow = process.workflows.value(result.target);
-    bool found    = false;
-    for (auto &rule : workflow.conditions) {
-        auto const &[min, max] = ranges[rule.varName];
+    if (result.type != ResultType::Jump)
+        return 0;
+
+    std::atomic<qint64> forkedTotal{0};
+    utils::TaskGroup    group;
+
+    const auto &workflow = process.workflows[result.target];
+    bool        found    = false;
+    for (const auto &rule : workflow.conditions) {
+        auto const &[min, max] = ranges[rule.category];
         Range t, f;
         if (rule.type == ConditionType::LowerThan) {
             t = {min, rule.number - 1};
@@ -245,12 +297,18 @@ qint64 count(QHash<QString, Range> ranges, const Result &result, const Process &
         }
 
         if (t.min <= t.max) {
-            auto newRanges          = ranges;
-            newRanges[rule.varName] = t;
-            total += count(newRanges, rule.result, process);
+            auto newRanges           = ranges;
+            newRanges[rule.category] = t;
+            if (depth < forkDepth) {
+                group.run([&forkedTotal, &process, newRanges, next = rule.result, depth] {
+                    forkedTotal += count(newRanges, next, process, depth + 1);
+                });
+            } else {
+                total += count(newRanges, rule.result, process, depth + 1);
+            }
         }
         if (f.min <= f.max) {
-            ranges[rule.varName] = f;
+            ranges[rule.category] = f;
         } else {
             found = true;
             break;
@@ -258,35 +316,28 @@ qint64 count(QHash<QString, Range> ranges, const Result &result, const Process &
     }
 
     if (!found)
-        total += count(ranges, workflow.def.result, process);
+        total += count(ranges, workflow.def.result, process, depth + 1);
 
-    return total;
+    group.wait();
+    return total + forkedTotal;
 }
 
 QString part1(const QString &fileName)
 {
-    auto process = Process::parse(fileName);
+    utils::PhaseProbe probe("parse");
+    auto              process = Process::parse(fileName);
+    probe.next("solve");
     return QString::number(process.run());
 }
 
 QString part2(const QString &fileName)
 {
-    QHash<QString, Range> ranges{
-        {"x", {}},
-        {"m", {}},
-        {"a", {}},
-        {"s", {}},
-    };
-
-    auto process = Process::parse(fileName);
-    auto result  = count(ranges, Result{.target = "in"}, process);
+    utils::PhaseProbe probe("parse");
+    auto              process = Process::parse(fileName);
+    probe.next("solve");
+    const Ranges ranges(process.categoryCount);
+    const auto   result = count(ranges, Result{.type = ResultType::Jump, .target = process.in}, process);
     return QString::number(result);
 }
 
 } // namespace day19
-
-int main()
-{
-    qDebug() << "Part 1: " << day19::part1(":/input.txt");
-    qDebug() << "Part 2: " << day19::part2(":/input.txt");
-}
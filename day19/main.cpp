@@ -0,0 +1,8 @@
+#include "day19.h"
+
+#include "dayrunner.h"
+
+int main(int argc, char *argv[])
+{
+    return utils::runDay(argc, argv, day19::part1, day19::part2);
+}
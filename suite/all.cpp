@@ -0,0 +1,168 @@
+#include "benchmark.h"
+#include "days.h"
+#include "taskpool.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+
+#include <algorithm>
+#include <exception>
+#include <latch>
+
+namespace {
+
+struct Job
+{
+    const suite::Day *day  = nullptr;
+    int               part = 0;
+    QString           fileName;
+
+    // filled in by the worker, every job owns its slot so no locking is needed
+    QString                   answer;
+    QString                   error; // what the part threw, if it did
+    qint64                    startNs    = 0;
+    qint64                    durationNs = 0;
+    quintptr                  thread     = 0;
+    QVector<suite::PhaseTime> phases;
+
+    [[nodiscard]] QJsonObject toJson() const
+    {
+        QJsonObject phasesObject;
+        for (const auto &phase : phases)
+            phasesObject[phase.name] = phase.ns;
+
+        QJsonObject result{
+            {"day",         day->number            },
+            {"part",        part                   },
+            {"answer",      answer                 },
+            {"start_ns",    startNs                },
+            {"duration_ns", durationNs             },
+            {"thread",      QString::number(thread)},
+            {"phases_ns",   phasesObject           },
+        };
+        if (!error.isEmpty())
+            result["error"] = error;
+        return result;
+    }
+};
+
+QString formatDuration(qint64 ns)
+{
+    return QStringLiteral("%1 ms").arg(static_cast<double>(ns) / 1e6, 0, 'f', 3);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("aoc_all");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs part1/part2 of every day concurrently on a shared thread pool.");
+    parser.addHelpOption();
+
+    const QCommandLineOption dayOption({"d", "day"}, "Only run <day>, may be given multiple times.", "day");
+    const QCommandLineOption threadsOption({"j", "threads"},
+                                           "Number of worker threads, defaults to the number of cores.",
+                                           "count");
+    const QCommandLineOption inputDirOption({"i", "input-dir"},
+                                           "Read <dir>/dayNN/input.txt instead of the source tree inputs.",
+                                           "dir");
+    const QCommandLineOption outputOption({"o", "output"}, "Write the JSON report to <file> instead of stdout.", "file");
+    parser.addOptions({dayOption, threadsOption, inputDirOption, outputOption});
+    parser.process(app);
+
+    // the days parallelize on the same pool, so the cores are not oversubscribed
+    if (parser.isSet(threadsOption))
+        utils::TaskPool::setInstanceThreadCount(qMax(1, parser.value(threadsOption).toInt()));
+    auto &pool = utils::TaskPool::instance();
+
+    QVector<Job> jobs;
+    for (const auto *day : suite::selectDays(parser.values(dayOption))) {
+        const auto fileName = day->inputFile(parser.value(inputDirOption));
+        for (const int part : {1, 2})
+            jobs.append({day, part, fileName});
+    }
+
+    QElapsedTimer wallClock;
+    wallClock.start();
+    // the jobs are pushed rather than run in a TaskGroup, so that this thread
+    // only waits and the workers never nest one job in the wait of another
+    std::latch done(jobs.size());
+    for (auto &job : jobs) {
+        pool.push([&job, &wallClock, &done] {
+            job.thread  = reinterpret_cast<quintptr>(QThread::currentThreadId());
+            job.startNs = wallClock.nsecsElapsed();
+            suite::takePhaseTimes();
+            QElapsedTimer timer;
+            timer.start();
+            // a throwing part must still count down, or the wait never returns
+            try {
+                job.answer = job.day->part(job.part)(job.fileName);
+            } catch (const std::exception &exception) {
+                job.error = QString::fromLocal8Bit(exception.what());
+            } catch (...) {
+                job.error = QStringLiteral("unknown exception");
+            }
+            job.durationNs = timer.nsecsElapsed();
+            job.phases     = suite::takePhaseTimes();
+            done.count_down();
+        });
+    }
+    done.wait();
+    const auto wallNs = wallClock.nsecsElapsed();
+
+    // the jobs are independent, so the slowest one is the critical path
+    qint64     serialNs       = 0;
+    qint64     criticalPathNs = 0;
+    int        failures       = 0;
+    QJsonArray results;
+    for (const auto &job : jobs) {
+        if (job.error.isEmpty()) {
+            qInfo().noquote() << job.day->name() << "part" << job.part << formatDuration(job.durationNs) << "->"
+                              << job.answer;
+        } else {
+            qWarning().noquote() << job.day->name() << "part" << job.part << "failed:" << job.error;
+            ++failures;
+        }
+        serialNs += job.durationNs;
+        criticalPathNs = std::max(criticalPathNs, job.durationNs);
+        results.append(job.toJson());
+    }
+    qInfo().noquote() << "wall" << formatDuration(wallNs) << "critical path" << formatDuration(criticalPathNs)
+                      << "serial" << formatDuration(serialNs) << "on" << pool.threadCount() << "threads";
+
+    const QJsonObject report{
+        {"threads",          pool.threadCount()},
+        {"wall_ns",          wallNs            },
+        {"critical_path_ns", criticalPathNs    },
+        {"serial_ns",        serialNs          },
+        {"failures",         failures          },
+        {"results",          results           },
+    };
+    const auto json = QJsonDocument(report).toJson();
+
+    if (!parser.isSet(outputOption)) {
+        QFile out;
+        if (!out.open(stdout, QIODevice::WriteOnly))
+            return 1;
+        out.write(json);
+        return failures > 0 ? 1 : 0;
+    }
+
+    QFile out(parser.value(outputOption));
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open file" << out.fileName();
+        return 1;
+    }
+    out.write(json);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,219 @@
+// Global allocation function replacements that feed utils::allocationStats().
+// Linked into aoc_micro, and into aoc_bench of -DAOC_ALLOC_STATS=ON builds.
+//
+// Qt's containers allocate through malloc() and realloc() rather than
+// operator new, so with glibc the malloc family is replaced as well and
+// forwards to glibc's own implementation. Elsewhere only operator new is
+// counted, and utils::allocationsCounted() reports whether Qt's are seen.
+
+#include "allocstats.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+void  __libc_free(void *p);
+}
+#endif
+
+namespace {
+
+// allocations that are already counted, by operator new
+void *rawAllocate(std::size_t size)
+{
+#if defined(__GLIBC__)
+    return __libc_malloc(size);
+#else
+    return std::malloc(size);
+#endif
+}
+
+void *rawAllocateAligned(std::size_t size, std::size_t align)
+{
+#if defined(__GLIBC__)
+    return __libc_memalign(align, size);
+#elif defined(_MSC_VER)
+    return _aligned_malloc(size, align);
+#else
+    // aligned_alloc wants a multiple of the alignment
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void rawFree(void *p)
+{
+#if defined(__GLIBC__)
+    __libc_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void *allocate(std::size_t size)
+{
+    utils::countAllocation(size);
+    return rawAllocate(size == 0 ? 1 : size);
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    utils::countAllocation(size);
+    const auto align = static_cast<std::size_t>(alignment);
+    return rawAllocateAligned(size == 0 ? align : size, align);
+}
+
+void freeAligned(void *p)
+{
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    rawFree(p);
+#endif
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+
+void *malloc(std::size_t size)
+{
+    utils::countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    utils::countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+// a realloc may move the block, so it counts as an allocation of the new size
+void *realloc(void *p, std::size_t size)
+{
+    if (size != 0 || !p)
+        utils::countAllocation(size);
+    return __libc_realloc(p, size);
+}
+
+void free(void *p)
+{
+    __libc_free(p);
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size)
+{
+    utils::countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *memalign(std::size_t alignment, std::size_t size)
+{
+    utils::countAllocation(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **result, std::size_t alignment, std::size_t size)
+{
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    utils::countAllocation(size);
+    void *p = __libc_memalign(alignment, size);
+    if (!p)
+        return ENOMEM;
+    *result = p;
+    return 0;
+}
+
+} // extern "C"
+#endif
+
+void *operator new(std::size_t size)
+{
+    if (auto *p = allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto *p = allocateAligned(size, alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void *p) noexcept
+{
+    rawFree(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    rawFree(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    rawFree(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    rawFree(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept
+{
+    freeAligned(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept
+{
+    freeAligned(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept
+{
+    freeAligned(p);
+}
@@ -0,0 +1,157 @@
+#include "baseline.h"
+
+#include "allocstats.h"
+#include "probes.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace suite {
+
+QJsonObject buildInfo()
+{
+    return {
+        {"host",        QSysInfo::machineHostName()       },
+        {"os",          QSysInfo::prettyProductName()     },
+        {"kernel",      QSysInfo::kernelVersion()         },
+        {"cpu",         QSysInfo::currentCpuArchitecture()},
+        {"threads",     QThread::idealThreadCount()       },
+        {"qt",          QString::fromLatin1(qVersion())   },
+        {"compiler",    QStringLiteral(AOC_COMPILER)      },
+        {"build_type",  QStringLiteral(AOC_BUILD_TYPE)    },
+        {"cxx_flags",   QStringLiteral(AOC_CXX_FLAGS)     },
+        {"probes",      utils::probesEnabled              },
+        {"alloc_stats", utils::allocStatsEnabled          },
+    };
+}
+
+std::optional<Baseline> Baseline::load(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file" << fileName;
+        return {};
+    }
+
+    QJsonParseError error;
+    const auto      document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (!document.isObject()) {
+        qWarning() << "Invalid baseline" << fileName << error.errorString();
+        return {};
+    }
+
+    const auto root = document.object();
+    Baseline   baseline;
+    baseline.label = root["label"].toString();
+    baseline.build = root["build"].toObject();
+    for (const auto &value : root["results"].toArray()) {
+        const auto object = value.toObject();
+        Result     result;
+        result.day  = object["day"].toInt();
+        result.part = object["part"].toInt();
+        for (const auto &sample : object["samples_ns"].toArray())
+            result.samples.append(sample.toInteger());
+        result.statistics = Statistics::fromSamples(result.samples);
+        baseline.results.append(result);
+    }
+    return baseline;
+}
+
+const Baseline::Result *Baseline::find(int day, int part) const
+{
+    const auto it = std::ranges::find_if(results, [=](const Result &r) { return r.day == day && r.part == part; });
+    return it != results.end() ? &*it : nullptr;
+}
+
+double mannWhitneyPValue(const QVector<qint64> &a, const QVector<qint64> &b)
+{
+    const auto n1 = static_cast<double>(a.size());
+    const auto n2 = static_cast<double>(b.size());
+    if (a.isEmpty() || b.isEmpty())
+        return 1.0;
+
+    // samples of both sets in ascending order, second is whether it is from a
+    QVector<std::pair<qint64, bool>> all;
+    all.reserve(a.size() + b.size());
+    for (const auto sample : a)
+        all.append({sample, true});
+    for (const auto sample : b)
+        all.append({sample, false});
+    std::ranges::sort(all);
+
+    // tied samples share their average rank
+    double rankSumA = 0.0;
+    double tieTerm  = 0.0;
+    for (qsizetype first = 0; first < all.size();) {
+        auto last = first + 1;
+        while (last < all.size() && all[last].first == all[first].first)
+            ++last;
+        const auto ties = static_cast<double>(last - first);
+        const auto rank = static_cast<double>(first + last + 1) / 2.0;
+        for (auto i = first; i < last; ++i) {
+            if (all[i].second)
+                rankSumA += rank;
+        }
+        tieTerm += ties * ties * ties - ties;
+        first = last;
+    }
+
+    const auto n     = n1 + n2;
+    const auto u     = rankSumA - n1 * (n1 + 1.0) / 2.0;
+    const auto mean  = n1 * n2 / 2.0;
+    const auto sigma = std::sqrt(n1 * n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0))));
+    if (sigma <= 0.0)
+        return 1.0;
+
+    // with continuity correction
+    const auto z = std::max(std::abs(u - mean) - 0.5, 0.0) / sigma;
+    return std::erfc(z / std::numbers::sqrt2);
+}
+
+QJsonObject Comparison::toJson() const
+{
+    static constexpr const char *changeNames[] = {"none", "improvement", "regression"};
+    return {
+        {"day",                day                                  },
+        {"part",               part                                 },
+        {"baseline_median_ns", baselineMedian                       },
+        {"median_ns",          median                               },
+        {"delta",              delta                                },
+        {"p_value",            pValue                               },
+        {"change",             changeNames[static_cast<int>(change)]},
+    };
+}
+
+Comparison compare(const Baseline::Result &baseline, const BenchmarkResult &result, const ComparisonOptions &options)
+{
+    Comparison comparison;
+    comparison.day            = result.day;
+    comparison.part           = result.part;
+    comparison.baselineMedian = baseline.statistics.median;
+    comparison.median         = result.statistics.median;
+    if (comparison.baselineMedian > 0) {
+        comparison.delta = static_cast<double>(comparison.median - comparison.baselineMedian)
+                           / static_cast<double>(comparison.baselineMedian);
+    }
+    comparison.pValue = mannWhitneyPValue(baseline.samples, result.samples);
+
+    // a change must be both significant and large enough to matter
+    if (comparison.pValue < options.significanceLevel) {
+        if (comparison.delta > options.threshold)
+            comparison.change = Comparison::Change::Regression;
+        else if (comparison.delta < -options.threshold)
+            comparison.change = Comparison::Change::Improvement;
+    }
+    return comparison;
+}
+
+} // namespace suite
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "benchmark.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+#include <optional>
+
+namespace suite {
+
+// host, compiler and build configuration of the running executable
+QJsonObject buildInfo();
+
+// A stored aoc_bench report to compare later runs against.
+struct Baseline
+{
+    struct Result
+    {
+        int             day  = 0;
+        int             part = 0;
+        QVector<qint64> samples;
+        Statistics      statistics;
+    };
+
+    QString         label;
+    QJsonObject     build;
+    QVector<Result> results;
+
+    static std::optional<Baseline> load(const QString &fileName);
+
+    [[nodiscard]] const Result *find(int day, int part) const;
+};
+
+// Two-sided p-value of the Mann-Whitney U test, normal approximation with tie
+// correction. Small values mean the samples are unlikely to come from the same
+// distribution; unlike a t-test it does not assume normally distributed times.
+double mannWhitneyPValue(const QVector<qint64> &a, const QVector<qint64> &b);
+
+struct ComparisonOptions
+{
+    // relative change of the median that counts as a change at all
+    double threshold         = 0.05;
+    double significanceLevel = 0.05;
+};
+
+struct Comparison
+{
+    enum class Change { None, Improvement, Regression };
+
+    int    day            = 0;
+    int    part           = 0;
+    qint64 baselineMedian = 0;
+    qint64 median         = 0;
+    // relative change of the median, positive is slower
+    double delta  = 0.0;
+    double pValue = 1.0;
+    Change change = Change::None;
+
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+Comparison compare(const Baseline::Result &baseline, const BenchmarkResult &result, const ComparisonOptions &options);
+
+} // namespace suite
@@ -0,0 +1,269 @@
+#include "baseline.h"
+#include "benchmark.h"
+#include "days.h"
+#include "snapshot.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStringList>
+
+#include <optional>
+
+namespace {
+
+QString formatDuration(qint64 ns)
+{
+    return QStringLiteral("%1 ms").arg(static_cast<double>(ns) / 1e6, 0, 'f', 3);
+}
+
+QString formatAllocations(const utils::AllocationStats &allocations)
+{
+    return QStringLiteral("%1 allocations %2 KiB").arg(allocations.allocations).arg(allocations.bytes / 1024);
+}
+
+QString formatCounters(const suite::HardwareCounters &counters, qint64 inputBytes)
+{
+    QStringList parts;
+    if (counters.cycles && counters.instructions && *counters.cycles > 0)
+        parts.append(QString::asprintf("IPC %.2f", static_cast<double>(*counters.instructions) / *counters.cycles));
+    const auto perByte = [&](const char *name, const std::optional<qint64> &value) {
+        if (value && inputBytes > 0)
+            parts.append(QString::asprintf("%s/byte %.4f", name, static_cast<double>(*value) / inputBytes));
+    };
+    perByte("L1d misses", counters.l1dReadMisses);
+    perByte("LLC misses", counters.llcMisses);
+    perByte("branch misses", counters.branchMisses);
+    return parts.join(QStringLiteral(", "));
+}
+
+// Writes the report to fileName, or to stdout if it is empty.
+bool writeReport(const QByteArray &json, const QString &fileName)
+{
+    QFile out;
+    if (fileName.isEmpty()) {
+        if (!out.open(stdout, QIODevice::WriteOnly))
+            return false;
+    } else {
+        out.setFileName(fileName);
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "Failed to open file" << out.fileName();
+            return false;
+        }
+    }
+    out.write(json);
+    return true;
+}
+
+// Results are only comparable between equal builds on the same machine.
+void warnAboutBuildDifferences(const QJsonObject &baseline, const QJsonObject &current)
+{
+    for (const auto *name : {"host", "cpu", "compiler", "build_type", "cxx_flags", "probes", "alloc_stats"}) {
+        const QLatin1String key(name);
+        if (baseline[key] != current[key])
+            qWarning().noquote() << "The baseline was recorded with a different" << key << baseline[key].toVariant()
+                                 << "instead of" << current[key].toVariant();
+    }
+}
+
+QString describe(const suite::Comparison &comparison)
+{
+    switch (comparison.change) {
+    case suite::Comparison::Change::Improvement:
+        return QStringLiteral("improvement");
+    case suite::Comparison::Change::Regression:
+        return QStringLiteral("REGRESSION");
+    case suite::Comparison::Change::None:
+        break;
+    }
+    return QStringLiteral("no significant change");
+}
+
+// Runs the part again with the parsed inputs cached in directory and returns
+// that result, with the statistics of uncached for comparison.
+suite::BenchmarkResult compareWithSnapshots(const suite::Day       &day,
+                                            int                     part,
+                                            const QString          &fileName,
+                                            suite::BenchmarkOptions options,
+                                            suite::BenchmarkResult  uncached,
+                                            const QString          &directory)
+{
+    utils::setSnapshotDirectory(directory);
+    // the warm-up run writes the snapshot if there is none yet
+    options.warmup = qMax(options.warmup, 1);
+    auto result    = suite::runBenchmark(day, part, fileName, options);
+    utils::setSnapshotDirectory({});
+
+    if (result.answer != uncached.answer)
+        qWarning().noquote() << day.name() << "part" << part << "answers differ with snapshots:" << uncached.answer
+                             << result.answer;
+    result.uncachedStatistics = uncached.statistics;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("aoc_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times part1/part2 of every day and reports the statistics as JSON.");
+    parser.addHelpOption();
+
+    const QCommandLineOption dayOption({"d", "day"}, "Only run <day>, may be given multiple times.", "day");
+    const QCommandLineOption partOption({"p", "part"}, "Only run <part> (1 or 2).", "part");
+    const QCommandLineOption warmupOption({"w", "warmup"}, "Number of unmeasured warm-up runs.", "count", "1");
+    const QCommandLineOption repetitionsOption({"n", "repetitions"}, "Number of measured runs.", "count", "10");
+    const QCommandLineOption inputDirOption({"i", "input-dir"},
+                                            "Read <dir>/dayNN/input.txt instead of the source tree inputs.",
+                                            "dir");
+    const QCommandLineOption outputOption({"o", "output"}, "Write the JSON report to <file> instead of stdout.", "file");
+    const QCommandLineOption snapshotOption({"s", "snapshot-dir"},
+                                            "Also time the parts with parse snapshots cached in <dir> and report the "
+                                            "speedup over parsing.",
+                                            "dir");
+    const QCommandLineOption engineOption({"e", "engine"},
+                                          "Run the <name> engine of the days that have one, e.g. reference.",
+                                          "name");
+    const QCommandLineOption countersOption("counters",
+                                            "Read the hardware performance counters of every part (Linux only).");
+    const QCommandLineOption labelOption({"l", "label"}, "Label of the run, stored in the report.", "label");
+    const QCommandLineOption saveBaselineOption("save-baseline",
+                                                "Also write the report to <file>, as a baseline for --compare.",
+                                                "file");
+    const QCommandLineOption compareOption({"c", "compare"},
+                                           "Compare the run with the baseline report <file>, exits with 2 if any "
+                                           "part regressed.",
+                                           "file");
+    const QCommandLineOption thresholdOption("threshold",
+                                             "Change of the median in percent below which --compare reports no "
+                                             "regression, even if it is significant.",
+                                             "percent",
+                                             "5");
+    parser.addOptions({dayOption,
+                       partOption,
+                       warmupOption,
+                       repetitionsOption,
+                       inputDirOption,
+                       outputOption,
+                       snapshotOption,
+                       engineOption,
+                       countersOption,
+                       labelOption,
+                       saveBaselineOption,
+                       compareOption,
+                       thresholdOption});
+    parser.process(app);
+
+    // opened before the first day starts the workers of the task pool, which
+    // then inherit the counters
+    std::optional<suite::PerfCounters> perfCounters;
+    if (parser.isSet(countersOption))
+        perfCounters.emplace();
+
+    suite::BenchmarkOptions options;
+    options.warmup      = parser.value(warmupOption).toInt();
+    options.repetitions = qMax(1, parser.value(repetitionsOption).toInt());
+    options.counters    = perfCounters ? &*perfCounters : nullptr;
+
+    QVector<int> parts{1, 2};
+    if (parser.isSet(partOption))
+        parts = {parser.value(partOption).toInt()};
+
+    // the plain runs must parse, whatever AOC_SNAPSHOT_DIR says
+    const auto snapshotDir = parser.value(snapshotOption);
+    if (!snapshotDir.isEmpty())
+        utils::setSnapshotDirectory({});
+
+    const auto build = suite::buildInfo();
+
+    std::optional<suite::Baseline> baseline;
+    suite::ComparisonOptions       comparisonOptions;
+    if (parser.isSet(compareOption)) {
+        baseline = suite::Baseline::load(parser.value(compareOption));
+        if (!baseline)
+            return 1;
+        warnAboutBuildDifferences(baseline->build, build);
+        comparisonOptions.threshold = parser.value(thresholdOption).toDouble() / 100.0;
+    }
+
+    if constexpr (utils::allocStatsEnabled) {
+        if (!utils::allocationsCounted())
+            qWarning() << "The allocations of Qt containers are not counted on this platform";
+    }
+
+    QJsonArray results;
+    QJsonArray comparisons;
+    bool       regressed = false;
+    for (const auto *selected : suite::selectDays(parser.values(dayOption))) {
+        auto day = *selected;
+        if (const auto *engine = day.engine(parser.value(engineOption)))
+            day = day.withEngine(*engine);
+        const auto fileName = day.inputFile(parser.value(inputDirOption));
+        for (const auto part : parts) {
+            auto result = suite::runBenchmark(day, part, fileName, options);
+            if (!snapshotDir.isEmpty())
+                result = compareWithSnapshots(day, part, fileName, options, std::move(result), snapshotDir);
+            qInfo().noquote() << day.name() << "part" << part << "median" << formatDuration(result.statistics.median)
+                              << "min" << formatDuration(result.statistics.min) << "p99"
+                              << formatDuration(result.statistics.p99);
+            if constexpr (utils::allocStatsEnabled)
+                qInfo().noquote() << "   " << formatAllocations(result.allocations) << "peak RSS"
+                                  << result.peakRssBytes / (1024 * 1024) << "MiB";
+            for (const auto &phase : result.phases) {
+                if constexpr (utils::allocStatsEnabled)
+                    qInfo().noquote() << "   " << phase.name << "median" << formatDuration(phase.statistics.median)
+                                      << formatAllocations(phase.allocations);
+                else
+                    qInfo().noquote() << "   " << phase.name << "median" << formatDuration(phase.statistics.median);
+            }
+            if (result.counters)
+                qInfo().noquote() << "   " << formatCounters(*result.counters, result.inputBytes);
+            if (result.uncachedStatistics)
+                qInfo().noquote() << "    without snapshots median" << formatDuration(result.uncachedStatistics->median);
+            results.append(result.toJson());
+
+            if (!baseline)
+                continue;
+            const auto *baselineResult = baseline->find(day.number, part);
+            if (!baselineResult) {
+                qInfo().noquote() << "    not in the baseline";
+                continue;
+            }
+            const auto comparison = suite::compare(*baselineResult, result, comparisonOptions);
+            regressed             = regressed || comparison.change == suite::Comparison::Change::Regression;
+            qInfo().noquote() << "    vs" << (baseline->label.isEmpty() ? QStringLiteral("baseline") : baseline->label)
+                              << QString::asprintf("%+.1f%%", comparison.delta * 100) << "median"
+                              << formatDuration(comparison.baselineMedian) << "->" << formatDuration(comparison.median)
+                              << QString::asprintf("p=%.3g", comparison.pValue) << describe(comparison);
+            comparisons.append(comparison.toJson());
+        }
+    }
+
+    QJsonObject report{
+        {"warmup",      options.warmup     },
+        {"repetitions", options.repetitions},
+        {"build",       build              },
+        {"results",     results            },
+    };
+    if (parser.isSet(labelOption))
+        report["label"] = parser.value(labelOption);
+    if (parser.isSet(engineOption))
+        report["engine"] = parser.value(engineOption);
+    if (baseline) {
+        report["baseline"]   = baseline->label;
+        report["comparison"] = comparisons;
+    }
+    const auto json = QJsonDocument(report).toJson();
+
+    if (parser.isSet(saveBaselineOption) && !writeReport(json, parser.value(saveBaselineOption)))
+        return 1;
+    if (!writeReport(json, parser.value(outputOption)))
+        return 1;
+    return regressed ? 2 : 0;
+}
@@ -0,0 +1,186 @@
+#include "benchmark.h"
+
+#include "probes.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace suite {
+
+namespace {
+
+// nearest-rank percentile of sorted samples
+qint64 percentile(const QVector<qint64> &sorted, double p)
+{
+    const auto rank = static_cast<qsizetype>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+    return sorted.at(std::clamp<qsizetype>(rank - 1, 0, sorted.size() - 1));
+}
+
+QJsonObject allocationsToJson(const utils::AllocationStats &allocations)
+{
+    return {
+        {"allocations",     allocations.allocations},
+        {"allocated_bytes", allocations.bytes      },
+    };
+}
+
+} // namespace
+
+Statistics Statistics::fromSamples(QVector<qint64> samples)
+{
+    if (samples.isEmpty())
+        return {};
+
+    std::ranges::sort(samples);
+    const auto size = samples.size();
+
+    Statistics result;
+    result.min    = samples.first();
+    result.max    = samples.last();
+    result.median = size % 2 == 1 ? samples.at(size / 2) : (samples.at(size / 2 - 1) + samples.at(size / 2)) / 2;
+    result.p99    = percentile(samples, 99.0);
+    result.mean   = std::accumulate(samples.begin(), samples.end(), qint64{0}) / size;
+    return result;
+}
+
+QJsonObject Statistics::toJson() const
+{
+    return {
+        {"min_ns",    min   },
+        {"median_ns", median},
+        {"p99_ns",    p99   },
+        {"mean_ns",   mean  },
+        {"max_ns",    max   },
+    };
+}
+
+QVector<PhaseTime> takePhaseTimes()
+{
+    QVector<PhaseTime> result;
+    for (const auto &[phase, ns, allocations] : utils::takeProbeSamples()) {
+        const auto name = QString::fromLatin1(phase);
+        const auto it   = std::ranges::find(result, name, &PhaseTime::name);
+        if (it != result.end()) {
+            it->ns += ns;
+            it->allocations += allocations;
+        } else {
+            result.append({name, ns, allocations});
+        }
+    }
+    return result;
+}
+
+QJsonObject PhaseResult::toJson() const
+{
+    QJsonObject result{
+        {"phase",      name               },
+        {"statistics", statistics.toJson()},
+    };
+    if constexpr (utils::allocStatsEnabled)
+        result["memory"] = allocationsToJson(allocations);
+    return result;
+}
+
+QJsonObject BenchmarkResult::toJson() const
+{
+    QJsonArray samplesArray;
+    for (const auto sample : samples)
+        samplesArray.append(sample);
+
+    QJsonObject result{
+        {"day",        day                },
+        {"part",       part               },
+        {"input",      input              },
+        {"answer",     answer             },
+        {"statistics", statistics.toJson()},
+        {"samples_ns", samplesArray       },
+    };
+
+    if (!phases.isEmpty()) {
+        QJsonArray phasesArray;
+        for (const auto &phase : phases)
+            phasesArray.append(phase.toJson());
+        result["phases"] = phasesArray;
+    }
+
+    if constexpr (utils::allocStatsEnabled) {
+        auto memory              = allocationsToJson(allocations);
+        memory["peak_rss_bytes"] = peakRssBytes;
+        result["memory"]         = memory;
+    }
+
+    if (counters)
+        result["counters"] = counters->toJson(inputBytes);
+
+    if (uncachedStatistics) {
+        result["uncached_statistics"] = uncachedStatistics->toJson();
+        if (statistics.median > 0)
+            result["snapshot_speedup"] = static_cast<double>(uncachedStatistics->median) / statistics.median;
+    }
+    return result;
+}
+
+BenchmarkResult runBenchmark(const Day &day, int part, const QString &fileName, const BenchmarkOptions &options)
+{
+    const auto function = day.part(part);
+
+    BenchmarkResult result;
+    result.day   = day.number;
+    result.part  = part;
+    result.input = fileName;
+
+    for (int i = 0; i < options.warmup; ++i)
+        result.answer = function(fileName);
+
+    takePhaseTimes();
+
+    HardwareCounters counterSum;
+    const bool       countHardware = options.counters && options.counters->isAvailable();
+
+    QElapsedTimer timer;
+    result.samples.reserve(options.repetitions);
+    for (int i = 0; i < options.repetitions; ++i) {
+        if constexpr (utils::allocStatsEnabled)
+            utils::resetPeakRss();
+        const auto allocationsBefore = utils::allocationStats();
+
+        if (countHardware)
+            options.counters->start();
+        timer.start();
+        auto answer = function(fileName);
+        result.samples.append(timer.nsecsElapsed());
+        if (countHardware)
+            counterSum += options.counters->stop();
+
+        if constexpr (utils::allocStatsEnabled) {
+            result.allocations  = utils::allocationStats() - allocationsBefore;
+            result.peakRssBytes = qMax(result.peakRssBytes, utils::peakRss());
+        }
+        result.answer = std::move(answer);
+
+        for (const auto &[name, ns, allocations] : takePhaseTimes()) {
+            auto it = std::ranges::find(result.phases, name, &PhaseResult::name);
+            if (it == result.phases.end())
+                it = result.phases.insert(result.phases.end(), PhaseResult{name});
+            it->samples.append(ns);
+            it->allocations = allocations;
+        }
+    }
+
+    if (countHardware) {
+        result.counters   = counterSum.averaged(options.repetitions);
+        result.inputBytes = QFileInfo(fileName).size();
+    }
+
+    result.statistics = Statistics::fromSamples(result.samples);
+    for (auto &phase : result.phases)
+        phase.statistics = Statistics::fromSamples(phase.samples);
+    return result;
+}
+
+} // namespace suite
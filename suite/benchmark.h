@@ -0,0 +1,82 @@
+#pragma once
+
+#include "allocstats.h"
+#include "days.h"
+#include "perfcounters.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+#include <optional>
+
+namespace suite {
+
+struct BenchmarkOptions
+{
+    int           warmup      = 1;
+    int           repetitions = 10;
+    PerfCounters *counters    = nullptr; // read the hardware counters if set
+};
+
+// wall times of the measured repetitions in nanoseconds
+struct Statistics
+{
+    qint64 min    = 0;
+    qint64 median = 0;
+    qint64 p99    = 0;
+    qint64 mean   = 0;
+    qint64 max    = 0;
+
+    static Statistics fromSamples(QVector<qint64> samples);
+
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+// total time of one phase during a single run, see utils::PhaseProbe
+struct PhaseTime
+{
+    QString                name;
+    qint64                 ns = 0;
+    utils::AllocationStats allocations;
+};
+
+// phase times recorded on the calling thread since the last call, in order of
+// first appearance; always empty unless built with AOC_PROBES
+QVector<PhaseTime> takePhaseTimes();
+
+struct PhaseResult
+{
+    QString                name;
+    QVector<qint64>        samples;
+    Statistics             statistics;
+    utils::AllocationStats allocations; // of the last run, with AOC_ALLOC_STATS
+
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+struct BenchmarkResult
+{
+    int                  day  = 0;
+    int                  part = 0;
+    QString              input;
+    QString              answer;
+    QVector<qint64>      samples;
+    Statistics           statistics;
+    QVector<PhaseResult> phases;
+    // Allocations of the last run and the peak RSS over all measured runs.
+    // Only collected with AOC_ALLOC_STATS; the counters cover all threads.
+    utils::AllocationStats allocations;
+    qint64                 peakRssBytes = 0;
+    // mean hardware counters of the measured runs, if they were read
+    std::optional<HardwareCounters> counters;
+    qint64                          inputBytes = 0;
+    // of the same runs without parse snapshots, if those were compared
+    std::optional<Statistics> uncachedStatistics;
+
+    [[nodiscard]] QJsonObject toJson() const;
+};
+
+BenchmarkResult runBenchmark(const Day &day, int part, const QString &fileName, const BenchmarkOptions &options);
+
+} // namespace suite
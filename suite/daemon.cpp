@@ -0,0 +1,274 @@
+#include "benchmark.h"
+#include "days.h"
+#include "snapshot.h"
+#include "taskpool.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+
+namespace {
+
+const QString defaultServerName = QStringLiteral("aoc-solver");
+
+// the longest a client waits for an answer
+constexpr int requestTimeoutMs = 10 * 60 * 1000;
+
+QString formatDuration(qint64 ns)
+{
+    return QStringLiteral("%1 ms").arg(static_cast<double>(ns) / 1e6, 0, 'f', 3);
+}
+
+QByteArray toLine(const QJsonObject &object)
+{
+    return QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+}
+
+QJsonObject error(const QString &message)
+{
+    return {
+        {"error", message},
+    };
+}
+
+// Solves requests of local clients in one long running process, so that they
+// do not pay for the process start and the Qt start-up. The task pool stays
+// alive between requests, and the answers are kept keyed by the file, its size
+// and its modification time, so that repeating a request for an unchanged
+// input does not run the day again. No day keeps its parsed input: the days
+// with parse snapshots (day08, day10 and day19) keep the snapshot payloads in
+// memory, but still map, hash and deserialize them when they run, and the
+// other days parse their input again.
+//
+// The socket is only accessible to the user running the daemon.
+//
+// A request is one line, every reply one line of compact JSON:
+//   solve <day> <part> <file>   the answer and the time it took, cached: true
+//                               if the answer was known
+//   stats                       number of requests and their mean latency
+//   ping
+// Requests are solved one after another in the order they arrive.
+class Daemon
+{
+public:
+    bool listen(const QString &name)
+    {
+        QObject::connect(&_server, &QLocalServer::newConnection, [this] {
+            while (auto *socket = _server.nextPendingConnection()) {
+                QObject::connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+                QObject::connect(socket, &QLocalSocket::readyRead, socket, [this, socket] { handle(socket); });
+            }
+        });
+
+        // the requests name arbitrary files, other users must not send them
+        _server.setSocketOptions(QLocalServer::UserAccessOption);
+        if (_server.listen(name))
+            return true;
+
+        // a socket left behind by a daemon that did not shut down cleanly
+        if (_server.serverError() == QAbstractSocket::AddressInUseError) {
+            QLocalSocket probe;
+            probe.connectToServer(name);
+            if (probe.waitForConnected(100)) {
+                qWarning() << "Another daemon is listening on" << name;
+                return false;
+            }
+            QLocalServer::removeServer(name);
+            if (_server.listen(name))
+                return true;
+        }
+        qWarning() << "Failed to listen on" << name << _server.errorString();
+        return false;
+    }
+
+    [[nodiscard]] QString fullServerName() const { return _server.fullServerName(); }
+
+private:
+    void handle(QLocalSocket *socket)
+    {
+        while (socket->canReadLine()) {
+            QElapsedTimer latency;
+            latency.start();
+
+            const auto request = QString::fromUtf8(socket->readLine()).trimmed();
+            auto       reply   = answer(request);
+
+            const auto ns       = latency.nsecsElapsed();
+            reply["latency_ns"] = ns;
+            socket->write(toLine(reply));
+            socket->flush();
+
+            ++_requests;
+            _totalLatencyNs += ns;
+            const auto result = reply.value("answer").toString(reply.value("error").toString());
+            qInfo().noquote() << request << "->" << result << "in" << formatDuration(ns);
+        }
+    }
+
+    QJsonObject answer(const QString &request)
+    {
+        const auto command = request.section(' ', 0, 0);
+        if (command == QLatin1String("ping"))
+            return {};
+        if (command == QLatin1String("stats")) {
+            return {
+                {"requests",        _requests                                       },
+                {"mean_latency_ns", _requests > 0 ? _totalLatencyNs / _requests : 0},
+            };
+        }
+        if (command == QLatin1String("solve")) {
+            return solve(request.section(' ', 1, 1).toInt(), request.section(' ', 2, 2).toInt(),
+                         request.section(' ', 3));
+        }
+        return error(QStringLiteral("unknown request: %1").arg(request));
+    }
+
+    QJsonObject solve(int number, int part, const QString &fileName)
+    {
+        const auto *day = suite::findDay(number);
+        if (!day)
+            return error(QStringLiteral("unknown day %1").arg(number));
+        if (part != 1 && part != 2)
+            return error(QStringLiteral("invalid part %1").arg(part));
+        const QFileInfo info(fileName);
+        if (!info.exists())
+            return error(QStringLiteral("no such file: %1").arg(fileName));
+
+        const auto key = QStringLiteral("%1 %2 %3 %4 %5")
+                             .arg(number)
+                             .arg(part)
+                             .arg(info.size())
+                             .arg(info.lastModified().toMSecsSinceEpoch())
+                             .arg(info.absoluteFilePath());
+        if (const auto it = _answers.constFind(key); it != _answers.cend()) {
+            return {
+                {"day",    number},
+                {"part",   part  },
+                {"answer", *it   },
+                {"cached", true  },
+            };
+        }
+
+        suite::takePhaseTimes();
+        QElapsedTimer timer;
+        timer.start();
+        const auto answer = day->part(part)(fileName);
+        const auto solve  = timer.nsecsElapsed();
+
+        QJsonObject phases;
+        for (const auto &phase : suite::takePhaseTimes())
+            phases[phase.name] = phase.ns;
+        _answers.insert(key, answer);
+
+        return {
+            {"day",       number},
+            {"part",      part  },
+            {"answer",    answer},
+            {"solve_ns",  solve },
+            {"phases_ns", phases},
+        };
+    }
+
+    QLocalServer _server;
+    // answers by day, part, size, modification time and file
+    QHash<QString, QString> _answers;
+    qint64                  _requests       = 0;
+    qint64                  _totalLatencyNs = 0;
+};
+
+// Sends one request to a running daemon and prints the reply.
+int sendRequest(const QString &serverName, const QString &request)
+{
+    QElapsedTimer roundTrip;
+    roundTrip.start();
+
+    QLocalSocket socket;
+    socket.connectToServer(serverName);
+    if (!socket.waitForConnected(1000)) {
+        qWarning() << "No daemon listening on" << serverName << socket.errorString();
+        return 1;
+    }
+    socket.write(request.toUtf8() + '\n');
+    socket.flush();
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(requestTimeoutMs)) {
+            qWarning() << "No reply from" << serverName << socket.errorString();
+            return 1;
+        }
+    }
+
+    const auto reply = socket.readLine();
+    QFile      out;
+    if (!out.open(stdout, QIODevice::WriteOnly))
+        return 1;
+    out.write(reply);
+    qInfo().noquote() << "round trip" << formatDuration(roundTrip.nsecsElapsed());
+    return QJsonDocument::fromJson(reply).object().contains("error") ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("aoc_daemon");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Solves the days for local clients in a long running process, or sends such a "
+                                     "request to it. Answers are kept for unchanged files; parsed inputs are not, "
+                                     "only day08, day10 and day19 keep their parse snapshots.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("request",
+                                 "With --send: <day> <part> [file], stats or ping. The file defaults to the input of "
+                                 "the day in the source tree.",
+                                 "[request...]");
+
+    const QCommandLineOption nameOption({"n", "name"}, "Name of the local socket.", "name", defaultServerName);
+    const QCommandLineOption sendOption({"s", "send"}, "Send the request to a running daemon and print the reply.");
+    const QCommandLineOption snapshotOption("snapshot-dir",
+                                            "Also keep the parse snapshots in <dir>, so that they survive restarts.",
+                                            "dir");
+    parser.addOptions({nameOption, sendOption, snapshotOption});
+    parser.process(app);
+
+    const auto serverName = parser.value(nameOption);
+    if (parser.isSet(sendOption)) {
+        const auto arguments = parser.positionalArguments();
+        if (arguments.isEmpty())
+            parser.showHelp(1);
+        if (arguments.first() == QLatin1String("stats") || arguments.first() == QLatin1String("ping"))
+            return sendRequest(serverName, arguments.first());
+
+        const auto *day = suite::findDay(arguments.first().toInt());
+        if (!day || arguments.size() < 2) {
+            qWarning() << "Expected <day> <part> [file]";
+            return 1;
+        }
+        // the daemon runs in another directory
+        const auto fileName = arguments.size() > 2 ? QFileInfo(arguments.at(2)).absoluteFilePath() : day->inputFile();
+        return sendRequest(serverName,
+                           QStringLiteral("solve %1 %2 %3").arg(day->number).arg(arguments.at(1), fileName));
+    }
+
+    utils::setMemorySnapshotsEnabled(true);
+    if (parser.isSet(snapshotOption))
+        utils::setSnapshotDirectory(parser.value(snapshotOption));
+
+    // start the worker threads now instead of in the first request
+    utils::TaskPool::instance();
+
+    Daemon daemon;
+    if (!daemon.listen(serverName))
+        return 1;
+    qInfo().noquote() << "Listening on" << daemon.fullServerName();
+    return QCoreApplication::exec();
+}
@@ -0,0 +1,109 @@
+#include "days.h"
+
+#include "day01.h"
+#include "day02.h"
+#include "day03.h"
+#include "day04.h"
+#include "day05.h"
+#include "day06.h"
+#include "day07.h"
+#include "day08.h"
+#include "day09.h"
+#include "day10.h"
+#include "day11.h"
+#include "day12.h"
+#include "day13.h"
+#include "day14.h"
+#include "day15.h"
+#include "day16.h"
+#include "day17.h"
+#include "day18.h"
+#include "day19.h"
+
+#include <QDebug>
+#include <QDir>
+
+#include <algorithm>
+
+namespace suite {
+
+namespace {
+
+// the original implementations of the days whose default engine is optimized
+const Engine day11Reference{referenceEngine, day11::reference::part1, day11::reference::part2};
+const Engine day16Reference{referenceEngine, day16::reference::part1, day16::reference::part2};
+
+} // namespace
+
+QString Day::inputFile(const QString &inputDir) const
+{
+    const QDir root(inputDir.isEmpty() ? QStringLiteral(AOC_SOURCE_DIR) : inputDir);
+    return root.filePath(name() + QStringLiteral("/input.txt"));
+}
+
+const Engine *Day::engine(const QString &name) const
+{
+    const auto it = std::ranges::find(engines, name, &Engine::name);
+    return it != engines.end() ? &*it : nullptr;
+}
+
+Day Day::withEngine(const Engine &engine) const
+{
+    auto day  = *this;
+    day.part1 = engine.part1;
+    day.part2 = engine.part2;
+    return day;
+}
+
+const QVector<Day> &days()
+{
+    static const QVector<Day> days{
+        {1,  Day01::part1, Day01::part2, generators::day01},
+        {2,  Day02::part1, Day02::part2, generators::day02},
+        {3,  Day03::part1, Day03::part2, generators::day03},
+        {4,  Day04::part1, Day04::part2, generators::day04},
+        {5,  Day05::part1, Day05::part2, generators::day05},
+        {6,  Day06::part1, Day06::part2, generators::day06},
+        {7,  day07::part1, day07::part2, generators::day07},
+        {8,  day08::part1, day08::part2, generators::day08},
+        {9,  day09::part1, day09::part2, generators::day09},
+        {10, day10::part1, day10::part2, generators::day10},
+        {11, day11::part1, day11::part2, generators::day11, {day11Reference}},
+        {12, day12::part1, day12::part2, generators::day12},
+        {13, day13::part1, day13::part2, generators::day13},
+        {14, day14::part1, day14::part2, generators::day14},
+        {15, day15::part1, day15::part2, generators::day15},
+        {16, day16::part1, day16::part2, generators::day16, {day16Reference}},
+        {17, day17::part1, day17::part2, generators::day17},
+        {18, day18::part1, day18::part2, generators::day18},
+        {19, day19::part1, day19::part2, generators::day19},
+    };
+    return days;
+}
+
+const Day *findDay(int number)
+{
+    const auto &all = days();
+    const auto  it  = std::ranges::find(all, number, &Day::number);
+    return it != all.end() ? &*it : nullptr;
+}
+
+QVector<const Day *> selectDays(const QStringList &numbers)
+{
+    QVector<const Day *> result;
+    if (numbers.isEmpty()) {
+        for (const auto &day : days())
+            result.append(&day);
+        return result;
+    }
+
+    for (const auto &number : numbers) {
+        if (const auto *day = findDay(number.toInt()))
+            result.append(day);
+        else
+            qWarning() << "Unknown day" << number;
+    }
+    return result;
+}
+
+} // namespace suite
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "generators.h"
+
+#include <QLatin1String>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace suite {
+
+using PartFunction = QString (*)(const QString &fileName);
+
+// One implementation of both parts of a day.
+struct Engine
+{
+    QString      name;
+    PartFunction part1 = nullptr;
+    PartFunction part2 = nullptr;
+};
+
+// name of the engine that keeps the original implementation of an optimized day
+inline constexpr QLatin1String referenceEngine("reference");
+
+struct Day
+{
+    int                        number   = 0;
+    PartFunction               part1    = nullptr;
+    PartFunction               part2    = nullptr;
+    generators::InputGenerator generate = nullptr;
+    // implementations next to the default part1/part2, which is the "default" engine
+    QVector<Engine> engines;
+
+    [[nodiscard]] QString name() const { return QStringLiteral("day%1").arg(number, 2, 10, QChar('0')); }
+
+    [[nodiscard]] PartFunction part(int part) const { return part == 1 ? part1 : part2; }
+
+    // the named engine, nullptr if the day has none of that name
+    [[nodiscard]] const Engine *engine(const QString &name) const;
+
+    // copy of the day that runs the given engine as its parts
+    [[nodiscard]] Day withEngine(const Engine &engine) const;
+
+    // input.txt of the day in the source tree, or below inputDir if given
+    [[nodiscard]] QString inputFile(const QString &inputDir = {}) const;
+};
+
+const QVector<Day> &days();
+
+const Day *findDay(int number);
+
+// all days if numbers is empty, unknown numbers are skipped with a warning
+QVector<const Day *> selectDays(const QStringList &numbers);
+
+} // namespace suite
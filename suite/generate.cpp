@@ -0,0 +1,291 @@
+#include "benchmark.h"
+#include "days.h"
+#include "generators.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+#include <cmath>
+#include <optional>
+
+namespace {
+
+QVector<int> parseScales(const QString &list)
+{
+    QVector<int> scales;
+    for (const auto &scale : list.split(',', Qt::SkipEmptyParts)) {
+        if (const int value = scale.trimmed().toInt(); value > 0)
+            scales.append(value);
+    }
+    return scales;
+}
+
+// every day gets its own stream so that adding a day does not change the others
+quint32 daySeed(quint32 seed, const suite::Day &day)
+{
+    return seed + static_cast<quint32>(day.number);
+}
+
+bool writeJson(const QJsonObject &report, const QString &fileName)
+{
+    const auto json = QJsonDocument(report).toJson();
+
+    if (fileName.isEmpty()) {
+        QFile out;
+        if (!out.open(stdout, QIODevice::WriteOnly))
+            return false;
+        out.write(json);
+        return true;
+    }
+
+    QFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Failed to open file" << out.fileName();
+        return false;
+    }
+    out.write(json);
+    return true;
+}
+
+// Day::inputFile() falls back to the inputs in the source tree for an empty
+// directory, so generated inputs may only be written into a valid one.
+bool checkTemporaryDir(const QTemporaryDir &dir)
+{
+    if (dir.isValid())
+        return true;
+    qWarning() << "Failed to create a temporary directory:" << dir.errorString();
+    return false;
+}
+
+// Generates every selected day at each scale and benchmarks it. The exponent
+// k of t ~ scale^k between two neighbouring scales shows how a part grows.
+std::optional<QJsonObject> scalingReport(const QVector<const suite::Day *> &days,
+                                         const QVector<int>                &scales,
+                                         quint32                            seed,
+                                         const suite::BenchmarkOptions     &options)
+{
+    QTemporaryDir dir;
+    if (!checkTemporaryDir(dir))
+        return {};
+
+    QJsonArray results;
+    for (const auto *day : days) {
+        QJsonArray curves[2];
+        qint64     previousMedian[2] = {0, 0};
+        int        previousScale     = 0;
+
+        for (const auto scale : scales) {
+            const auto fileName = day->inputFile(dir.path());
+            if (!suite::generators::writeInput(day->generate, fileName, scale, daySeed(seed, *day)))
+                break;
+            const auto bytes = QFileInfo(fileName).size();
+
+            for (const int part : {1, 2}) {
+                const auto result = suite::runBenchmark(*day, part, fileName, options);
+                const auto median = result.statistics.median;
+
+                QJsonObject point{
+                    {"scale",       scale                     },
+                    {"input_bytes", bytes                     },
+                    {"answer",      result.answer             },
+                    {"statistics",  result.statistics.toJson()},
+                };
+                if (previousScale > 0 && previousMedian[part - 1] > 0 && median > 0) {
+                    point["exponent"] = std::log(static_cast<double>(median) / previousMedian[part - 1])
+                                        / std::log(static_cast<double>(scale) / previousScale);
+                }
+                curves[part - 1].append(point);
+                previousMedian[part - 1] = median;
+
+                qInfo().noquote() << day->name() << "part" << part << "scale" << scale << "median"
+                                  << QStringLiteral("%1 ms").arg(static_cast<double>(median) / 1e6, 0, 'f', 3);
+            }
+            previousScale = scale;
+        }
+
+        for (const int part : {1, 2})
+            results.append(QJsonObject{
+                {"day",   day->number     },
+                {"part",  part            },
+                {"curve", curves[part - 1]},
+            });
+    }
+
+    QJsonArray scalesArray;
+    for (const auto scale : scales)
+        scalesArray.append(scale);
+
+    return {
+        {"seed",        static_cast<qint64>(seed)},
+        {"warmup",      options.warmup           },
+        {"repetitions", options.repetitions      },
+        {"scales",      scalesArray              },
+        {"results",     results                  },
+    };
+}
+
+// Runs the default engine and the reference engine of every selected day that
+// has one on count generated inputs and reports mismatching answers and the
+// speedup of the default engine. Input i is generated from seed + i, so a
+// mismatch can be reproduced with aoc_gen --seed.
+std::optional<QJsonObject> differentialReport(const QVector<const suite::Day *> &days, int scale, int count,
+                                              quint32 seed)
+{
+    QTemporaryDir dir;
+    if (!checkTemporaryDir(dir))
+        return {};
+
+    QJsonArray results;
+    int        totalMismatches = 0;
+    for (const auto *day : days) {
+        const auto *reference = day->engine(suite::referenceEngine);
+        if (!reference)
+            continue;
+        const auto referenceDay = day->withEngine(*reference);
+
+        qint64        defaultNs[2]   = {0, 0};
+        qint64        referenceNs[2] = {0, 0};
+        QJsonArray    mismatches[2];
+        int           checked = 0;
+        QElapsedTimer timer;
+        for (; checked < count; ++checked) {
+            const auto inputSeed = seed + static_cast<quint32>(checked);
+            const auto fileName  = day->inputFile(dir.path());
+            if (!suite::generators::writeInput(day->generate, fileName, scale, daySeed(inputSeed, *day)))
+                break;
+
+            for (const int part : {1, 2}) {
+                timer.start();
+                const auto answer = day->part(part)(fileName);
+                defaultNs[part - 1] += timer.nsecsElapsed();
+
+                timer.start();
+                const auto expected = referenceDay.part(part)(fileName);
+                referenceNs[part - 1] += timer.nsecsElapsed();
+
+                if (answer == expected)
+                    continue;
+                qWarning().noquote() << day->name() << "part" << part << "answers" << answer << "instead of" << expected
+                                     << "on aoc_gen -d" << day->number << "--scale" << scale << "--seed" << inputSeed;
+                mismatches[part - 1].append(QJsonObject{
+                    {"seed",      static_cast<qint64>(inputSeed)},
+                    {"answer",    answer                        },
+                    {"reference", expected                      },
+                });
+            }
+        }
+
+        for (const int part : {1, 2}) {
+            const auto speedup = defaultNs[part - 1] > 0
+                                     ? static_cast<double>(referenceNs[part - 1]) / defaultNs[part - 1]
+                                     : 0.0;
+            totalMismatches += static_cast<int>(mismatches[part - 1].size());
+            qInfo().noquote() << day->name() << "part" << part << checked << "inputs"
+                              << mismatches[part - 1].size() << "mismatches" << "speedup"
+                              << QStringLiteral("%1x").arg(speedup, 0, 'f', 2);
+            results.append(QJsonObject{
+                {"day",          day->number          },
+                {"part",         part                 },
+                {"inputs",       checked              },
+                {"default_ns",   defaultNs[part - 1]  },
+                {"reference_ns", referenceNs[part - 1]},
+                {"speedup",      speedup              },
+                {"mismatches",   mismatches[part - 1] },
+            });
+        }
+    }
+
+    return {
+        {"seed",       static_cast<qint64>(seed)},
+        {"scale",      scale                    },
+        {"count",      count                    },
+        {"mismatches", totalMismatches          },
+        {"results",    results                  },
+    };
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("aoc_gen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Writes synthetic inputs of any size for every day, measures how the days "
+                                     "scale with the input size, or checks optimized days against their reference.");
+    parser.addHelpOption();
+
+    const QCommandLineOption dayOption({"d", "day"}, "Only generate <day>, may be given multiple times.", "day");
+    const QCommandLineOption scaleOption({"s", "scale"}, "Input size relative to the real input.", "scale", "1");
+    const QCommandLineOption seedOption("seed", "Seed of the random generator.", "seed", "2023");
+    const QCommandLineOption outputDirOption({"o", "output-dir"},
+                                             "Write <dir>/dayNN/input.txt, readable by aoc_bench --input-dir.",
+                                             "dir",
+                                             "generated");
+    const QCommandLineOption scalingOption("scaling", "Benchmark every day at each of the --scales.");
+    const QCommandLineOption scalesOption("scales", "Comma separated scales for --scaling.", "list", "1,10,100");
+    const QCommandLineOption warmupOption({"w", "warmup"}, "Number of unmeasured warm-up runs.", "count", "1");
+    const QCommandLineOption repetitionsOption({"n", "repetitions"}, "Number of measured runs.", "count", "5");
+    const QCommandLineOption differentialOption("differential",
+                                                "Check the days that have a reference engine against it on --count "
+                                                "inputs of --scale and report the speedup of the default engine.");
+    const QCommandLineOption countOption("count", "Number of inputs for --differential.", "count", "100");
+    const QCommandLineOption jsonOption("json", "Write the report to <file> instead of stdout.", "file");
+    parser.addOptions({dayOption,
+                       scaleOption,
+                       seedOption,
+                       outputDirOption,
+                       scalingOption,
+                       scalesOption,
+                       warmupOption,
+                       repetitionsOption,
+                       differentialOption,
+                       countOption,
+                       jsonOption});
+    parser.process(app);
+
+    const auto days = suite::selectDays(parser.values(dayOption));
+    const auto seed = parser.value(seedOption).toUInt();
+
+    if (parser.isSet(scalingOption)) {
+        suite::BenchmarkOptions options;
+        options.warmup      = parser.value(warmupOption).toInt();
+        options.repetitions = qMax(1, parser.value(repetitionsOption).toInt());
+
+        const auto scales = parseScales(parser.value(scalesOption));
+        if (scales.isEmpty()) {
+            qWarning() << "No valid scales given";
+            return 1;
+        }
+        const auto report = scalingReport(days, scales, seed, options);
+        return report && writeJson(*report, parser.value(jsonOption)) ? 0 : 1;
+    }
+
+    const int scale = qMax(1, parser.value(scaleOption).toInt());
+
+    if (parser.isSet(differentialOption)) {
+        const auto count  = qMax(1, parser.value(countOption).toInt());
+        const auto report = differentialReport(days, scale, count, seed);
+        if (!report || !writeJson(*report, parser.value(jsonOption)))
+            return 1;
+        return (*report)["mismatches"].toInt() == 0 ? 0 : 1;
+    }
+
+    const QDir outputDir(parser.value(outputDirOption));
+    for (const auto *day : days) {
+        const auto fileName = day->inputFile(outputDir.path());
+        if (!suite::generators::writeInput(day->generate, fileName, scale, daySeed(seed, *day)))
+            return 1;
+        qInfo().noquote() << "Wrote" << fileName;
+    }
+    return 0;
+}
@@ -0,0 +1,641 @@
+#include "generators.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPoint>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <string_view>
+#include <tuple>
+
+namespace suite::generators {
+
+namespace {
+
+// side length of a square grid with scale times the cells of a base x base grid
+int side(int base, int scale)
+{
+    return qMax(1, qRound(base * std::sqrt(static_cast<double>(scale))));
+}
+
+bool chance(QRandomGenerator &random, int percent)
+{
+    return random.bounded(100) < percent;
+}
+
+char pick(std::string_view chars, QRandomGenerator &random)
+{
+    return chars[random.bounded(static_cast<int>(chars.size()))];
+}
+
+// index written as a fixed width number in the given alphabet
+QString encode(qint64 index, int width, std::string_view alphabet)
+{
+    QString result(width, QChar::fromLatin1(alphabet.front()));
+    for (int i = width - 1; i >= 0 && index > 0; --i) {
+        result[i] = QChar::fromLatin1(alphabet[index % static_cast<qint64>(alphabet.size())]);
+        index /= static_cast<qint64>(alphabet.size());
+    }
+    return result;
+}
+
+// smallest width so that count different names fit into the alphabet
+int encodedWidth(qint64 count, std::string_view alphabet, int minimum)
+{
+    int    width    = 1;
+    qint64 capacity = static_cast<qint64>(alphabet.size());
+    while (capacity < count) {
+        capacity *= static_cast<qint64>(alphabet.size());
+        width++;
+    }
+    return qMax(width, minimum);
+}
+
+// splits total into count positive parts
+QVector<qint64> splitEvenly(qint64 total, qint64 count)
+{
+    QVector<qint64> parts(count, total / count);
+    for (qint64 i = 0; i < total % count; ++i)
+        parts[i]++;
+    return parts;
+}
+
+void writeGrid(QTextStream &out, const QVector<QString> &grid)
+{
+    for (const auto &row : grid)
+        out << row << '\n';
+}
+
+} // namespace
+
+bool writeInput(InputGenerator generator, const QString &fileName, int scale, quint32 seed)
+{
+    if (!generator) {
+        qWarning() << "No generator for" << fileName;
+        return false;
+    }
+
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath())) {
+        qWarning() << "Failed to create directory for" << fileName;
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "Failed to open file" << fileName;
+        return false;
+    }
+
+    QRandomGenerator random(seed);
+    QTextStream      out(&file);
+    generator(out, scale, random);
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+void day01(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static const QStringList words{"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+
+    for (int line = 0; line < 1000 * scale; ++line) {
+        const int tokens  = random.bounded(2, 10);
+        const int digitAt = random.bounded(tokens); // every line needs at least one digit
+        for (int i = 0; i < tokens; ++i) {
+            const int kind = i == digitAt ? 0 : random.bounded(3);
+            if (kind == 0) {
+                out << static_cast<char>('0' + random.bounded(1, 10));
+            } else if (kind == 1) {
+                out << words.at(random.bounded(static_cast<int>(words.size())));
+            } else {
+                for (int n = random.bounded(1, 4); n > 0; --n)
+                    out << static_cast<char>('a' + random.bounded(26));
+            }
+        }
+        out << '\n';
+    }
+}
+
+void day02(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::array<const char *, 3> colors{"red", "green", "blue"};
+
+    for (int game = 1; game <= 100 * scale; ++game) {
+        out << "Game " << game << ": ";
+        const int sets = random.bounded(1, 7);
+        for (int set = 0; set < sets; ++set) {
+            if (set > 0)
+                out << "; ";
+            std::array order{0, 1, 2};
+            std::shuffle(order.begin(), order.end(), random);
+            const int count = random.bounded(1, 4);
+            for (int i = 0; i < count; ++i) {
+                if (i > 0)
+                    out << ", ";
+                out << random.bounded(1, 21) << ' ' << colors[order[i]];
+            }
+        }
+        out << '\n';
+    }
+}
+
+void day03(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr int               powers[] = {1, 10, 100, 1000};
+    static constexpr std::string_view symbols  = "*#+$/=%@&-";
+
+    const int size = side(140, scale);
+    for (int y = 0; y < size; ++y) {
+        int x = 0;
+        while (x < size) {
+            const int digits = random.bounded(1, 4);
+            if (chance(random, 12) && x + digits < size) {
+                out << random.bounded(powers[digits - 1], powers[digits]) << '.';
+                x += digits + 1;
+            } else {
+                out << (chance(random, 6) ? pick(symbols, random) : '.');
+                x++;
+            }
+        }
+        out << '\n';
+    }
+}
+
+void day04(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    constexpr int winningCount = 10;
+    constexpr int ownCount     = 25;
+
+    const int cards = 200 * scale;
+    const int width = static_cast<int>(QString::number(cards).size());
+
+    QVector<int> pool(99);
+    std::iota(pool.begin(), pool.end(), 1);
+
+    for (int card = 1; card <= cards; ++card) {
+        std::shuffle(pool.begin(), pool.end(), random);
+
+        // Copies won must stay on the table and few enough matches keep the
+        // number of instances from growing exponentially.
+        const int matches = qMin(cards - card, chance(random, 65) ? 0 : random.bounded(1, 5));
+
+        QVector<int> own = pool.mid(0, matches);
+        own.append(pool.mid(winningCount, ownCount - matches));
+        std::shuffle(own.begin(), own.end(), random);
+
+        out << "Card " << QString::number(card).rightJustified(width) << ':';
+        for (int i = 0; i < winningCount; ++i)
+            out << ' ' << QString::number(pool[i]).rightJustified(2);
+        out << " |";
+        for (const auto number : own)
+            out << ' ' << QString::number(number).rightJustified(2);
+        out << '\n';
+    }
+}
+
+void day05(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::array<const char *, 7> maps{
+        "seed-to-soil",
+        "soil-to-fertilizer",
+        "fertilizer-to-water",
+        "water-to-light",
+        "light-to-temperature",
+        "temperature-to-humidity",
+        "humidity-to-location",
+    };
+    constexpr qint64 space = 4'000'000'000;
+
+    out << "seeds:";
+    for (int i = 0; i < 10 * scale; ++i) {
+        const qint64 start = random.bounded(space);
+        out << ' ' << start << ' ' << 1 + random.bounded(qMin(space - start, qint64{500'000'000}));
+    }
+    out << '\n';
+
+    const int entries = 30 * scale;
+    for (const auto *name : maps) {
+        out << '\n' << name << " map:\n";
+
+        // the sources partition the whole space, the targets are the same blocks shuffled
+        QVector<qint64> cuts{0, space};
+        for (int i = 1; i < entries; ++i)
+            cuts.append(random.bounded(qint64{1}, space));
+        std::ranges::sort(cuts);
+        cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+        const auto         blocks = cuts.size() - 1;
+        QVector<qsizetype> order(blocks);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), random);
+
+        QVector<qint64> targets(blocks);
+        qint64          target = 0;
+        for (const auto block : order) {
+            targets[block] = target;
+            target += cuts[block + 1] - cuts[block];
+        }
+
+        for (qsizetype block = 0; block < blocks; ++block) {
+            if (chance(random, 10))
+                continue; // unmapped ranges keep their value
+            out << targets[block] << ' ' << cuts[block] << ' ' << cuts[block + 1] - cuts[block] << '\n';
+        }
+    }
+}
+
+void day06(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // Part 2 reads all digits of a line as one number and loops over the race
+    // time, so the input can only grow in digits. Four races with two digits
+    // each match the real input; one more digit (10x the work in part 2) is
+    // the most the 64 bit arithmetic of the puzzle allows.
+    constexpr int races = 4;
+
+    QVector<qint64> times;
+    QVector<qint64> distances;
+    for (int race = 0; race < races; ++race) {
+        const int    digits = race == 0 && scale >= 10 ? 3 : 2;
+        const qint64 low    = digits == 3 ? 100 : 10;
+        const qint64 time   = random.bounded(low, low * 10);
+        const qint64 best   = (time / 2) * (time - time / 2);
+        times.append(time);
+        distances.append(random.bounded(best / 4, best * 9 / 10));
+    }
+
+    out << "Time:    ";
+    for (const auto time : times)
+        out << ' ' << QString::number(time).rightJustified(6);
+    out << "\nDistance:";
+    for (const auto distance : distances)
+        out << ' ' << QString::number(distance).rightJustified(6);
+    out << '\n';
+}
+
+void day07(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::string_view cards = "23456789TJQKA";
+
+    for (int hand = 0; hand < 1000 * scale; ++hand) {
+        for (int i = 0; i < 5; ++i)
+            out << pick(cards, random);
+        out << ' ' << random.bounded(1, 1001) << '\n';
+    }
+}
+
+void day08(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // node names avoid A and Z, those mark the start and end nodes
+    static constexpr std::string_view letters = "BCDEFGHIJKLMNOPQRSTUVWXY";
+    constexpr int                     ghosts  = 6;
+
+    const int instructions = random.bounded(250, 300);
+    for (int i = 0; i < instructions; ++i)
+        out << (random.bounded(2) == 0 ? 'L' : 'R');
+    out << "\n\n";
+
+    // Every ghost walks its own chain, one or two nodes forward per step,
+    // and loops back from its end node to the start of the chain.
+    const int   chainLength = qMax(3, 750 * scale / ghosts);
+    const int   width       = encodedWidth(static_cast<qint64>(ghosts) * chainLength, letters, 3);
+    QStringList lines;
+    for (int ghost = 0; ghost < ghosts; ++ghost) {
+        QStringList chain;
+        chain << (ghost == 0 ? QStringLiteral("AAA") : encode(ghost, width - 1, letters) + QLatin1Char('A'));
+        for (int i = 1; i < chainLength - 1; ++i)
+            chain << encode(static_cast<qint64>(ghost) * chainLength + i, width, letters);
+        chain << (ghost == 0 ? QStringLiteral("ZZZ") : encode(ghost, width - 1, letters) + QLatin1Char('Z'));
+
+        const auto last = chain.size() - 1;
+        for (qsizetype i = 0; i < chain.size(); ++i) {
+            const auto &left  = i == last ? chain[1] : chain[i + 1];
+            const auto &right = i == last ? chain[1] : chain[qMin(i + 2, last)];
+            lines << QStringLiteral("%1 = (%2, %3)").arg(chain[i], left, right);
+        }
+    }
+
+    std::shuffle(lines.begin(), lines.end(), random);
+    for (const auto &line : lines)
+        out << line << '\n';
+}
+
+void day09(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // values of polynomials, so the differences end in zeros
+    for (int line = 0; line < 200 * scale; ++line) {
+        QVector<qint64> coefficients(random.bounded(2, 7));
+        for (auto &coefficient : coefficients)
+            coefficient = random.bounded(-9, 10);
+
+        for (qint64 x = 0; x < 21; ++x) {
+            qint64 value = 0;
+            for (const auto coefficient : coefficients)
+                value = value * x + coefficient;
+            out << (x > 0 ? " " : "") << value;
+        }
+        out << '\n';
+    }
+}
+
+void day10(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::string_view junk = "|-LJ7F";
+
+    const int size   = qMax(8, side(140, scale));
+    const int first  = 1;
+    const int last   = size - 2;
+    const int bottom = size - 2;
+
+    QVector<QString> grid(size);
+    for (auto &row : grid) {
+        row.resize(size);
+        for (auto &c : row)
+            c = QChar::fromLatin1(chance(random, 50) ? '.' : pick(junk, random));
+    }
+
+    // The loop follows a random skyline from left to right, goes down the
+    // right side, back along the bottom row and up the left side.
+    QVector<int> top(size);
+    int          height = random.bounded(1, bottom - 1);
+    for (int x = first; x <= last; ++x) {
+        height = qBound(1, height + random.bounded(-2, 3), bottom - 2);
+        top[x] = height;
+    }
+
+    QVector<QPoint> path;
+    int             current = top[first];
+    for (int x = first; x <= last; ++x) {
+        const int target = x == last ? bottom : top[x];
+        path.append({x, current});
+        while (current != target) {
+            current += current < target ? 1 : -1;
+            path.append({x, current});
+        }
+    }
+    for (int x = last - 1; x >= first; --x)
+        path.append({x, bottom});
+    for (int y = bottom - 1; y > top[first]; --y)
+        path.append({first, y});
+
+    const auto pipe = [](QPoint a, QPoint b) {
+        const auto has = [&](int dx, int dy) { return a == QPoint(dx, dy) || b == QPoint(dx, dy); };
+        if (has(0, -1) && has(0, 1))
+            return '|';
+        if (has(-1, 0) && has(1, 0))
+            return '-';
+        if (has(0, -1))
+            return has(1, 0) ? 'L' : 'J';
+        return has(1, 0) ? 'F' : '7';
+    };
+
+    const auto length = path.size();
+    for (qsizetype i = 0; i < length; ++i) {
+        const auto point = path[i];
+        const auto prev  = path[(i + length - 1) % length] - point;
+        const auto next  = path[(i + 1) % length] - point;
+        grid[point.y()][point.x()] = QChar::fromLatin1(pipe(prev, next));
+    }
+
+    // only the two loop neighbours of the start may connect to it
+    const auto start = random.bounded(static_cast<int>(length));
+    const auto s     = path[start];
+    for (const auto neighbour : {QPoint(0, -1), QPoint(1, 0), QPoint(0, 1), QPoint(-1, 0)}) {
+        const auto p = s + neighbour;
+        if (p != path[(start + length - 1) % length] && p != path[(start + 1) % length])
+            grid[p.y()][p.x()] = '.';
+    }
+    grid[s.y()][s.x()] = 'S';
+
+    writeGrid(out, grid);
+}
+
+void day11(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    const int     size = side(140, scale);
+    QVector<bool> emptyRows(size);
+    QVector<bool> emptyColumns(size);
+    for (int i = 0; i < size; ++i) {
+        emptyRows[i]    = chance(random, 8);
+        emptyColumns[i] = chance(random, 8);
+    }
+
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            out << (!emptyRows[y] && !emptyColumns[x] && chance(random, 2) ? '#' : '.');
+        out << '\n';
+    }
+}
+
+void day12(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // start from a valid arrangement and hide about half of it
+    for (int line = 0; line < 1000 * scale; ++line) {
+        QVector<int> groups(random.bounded(1, 7));
+        for (auto &group : groups)
+            group = random.bounded(1, 6);
+
+        QString springs(random.bounded(0, 3), '.');
+        for (qsizetype i = 0; i < groups.size(); ++i) {
+            if (i > 0)
+                springs += QString(random.bounded(1, 3), '.');
+            springs += QString(groups[i], '#');
+        }
+        springs += QString(random.bounded(0, 3), '.');
+
+        for (auto &c : springs) {
+            if (chance(random, 55))
+                c = '?';
+        }
+
+        out << springs << ' ';
+        for (qsizetype i = 0; i < groups.size(); ++i)
+            out << (i > 0 ? "," : "") << groups[i];
+        out << '\n';
+    }
+}
+
+void day13(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // Each pattern mirrors at a vertical line near its left edge and at a
+    // horizontal line. A smudge right of the vertically mirrored columns
+    // leaves the vertical line for part 1 and the horizontal one for part 2.
+    for (int pattern = 0; pattern < 100 * scale; ++pattern) {
+        const int rows = random.bounded(7, 18);
+        const int cols = random.bounded(7, 18);
+
+        QVector<QString> grid(rows);
+        for (auto &row : grid) {
+            row.resize(cols);
+            for (auto &c : row)
+                c = QChar::fromLatin1(chance(random, 50) ? '#' : '.');
+        }
+
+        const int vertical = random.bounded(1, (cols - 1) / 2 + 1);
+        for (auto &row : grid) {
+            for (int c = vertical; c < 2 * vertical; ++c)
+                row[c] = row[2 * vertical - 1 - c];
+        }
+
+        const int horizontal = random.bounded(1, rows);
+        for (int r = horizontal; r < rows && 2 * horizontal - 1 - r >= 0; ++r)
+            grid[r] = grid[2 * horizontal - 1 - r];
+
+        const int  mirrored = qMin(horizontal, rows - horizontal);
+        const int  r        = horizontal + random.bounded(mirrored);
+        const int  c        = random.bounded(2 * vertical, cols);
+        QChar     &smudge   = grid[r][c];
+        smudge              = smudge == '#' ? '.' : '#';
+
+        if (pattern > 0)
+            out << '\n';
+        writeGrid(out, grid);
+    }
+}
+
+void day14(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    const int size = side(100, scale);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            const int roll = random.bounded(100);
+            out << (roll < 20 ? 'O' : roll < 35 ? '#' : '.');
+        }
+        out << '\n';
+    }
+}
+
+void day15(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::string_view letters = "abcdefghijklmnopqrstuvwxyz";
+
+    QStringList labels;
+    for (int i = 0; i < 600; ++i) {
+        QString label;
+        for (int n = random.bounded(2, 7); n > 0; --n)
+            label += QChar::fromLatin1(pick(letters, random));
+        labels << label;
+    }
+
+    for (int step = 0; step < 4000 * scale; ++step) {
+        out << (step > 0 ? "," : "") << labels.at(random.bounded(static_cast<int>(labels.size())));
+        if (chance(random, 60))
+            out << '=' << random.bounded(1, 10);
+        else
+            out << '-';
+    }
+    out << '\n';
+}
+
+void day16(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::string_view devices = "|-/\\";
+
+    const int size = side(110, scale);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            out << (chance(random, 20) ? pick(devices, random) : '.');
+        out << '\n';
+    }
+}
+
+void day17(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    const int size = side(141, scale);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x)
+            out << static_cast<char>('0' + random.bounded(1, 10));
+        out << '\n';
+    }
+}
+
+void day18(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    // A staircase from the top left to the bottom right corner that returns
+    // along the left and top edges. The colour codes describe a second,
+    // larger staircase; its long return edges are split into several lines
+    // because a code holds at most five hex digits.
+    constexpr qint64 maxCodeSteps = 0xfffff;
+
+    struct Move
+    {
+        char   direction = 'R';
+        qint64 steps     = 0;
+        qint64 codeSteps = 0;
+    };
+
+    const int     stairs = 350 * scale;
+    QVector<Move> moves;
+    qint64        right = 0, down = 0, codeRight = 0, codeDown = 0;
+    for (int i = 0; i < stairs; ++i) {
+        const Move r{'R', random.bounded(1, 11), random.bounded(1, 0x20000)};
+        const Move d{'D', random.bounded(1, 11), random.bounded(1, 0x20000)};
+        right += r.steps;
+        down += d.steps;
+        codeRight += r.codeSteps;
+        codeDown += d.codeSteps;
+        moves << r << d;
+    }
+
+    for (const auto &[direction, total, codeTotal] :
+         {std::tuple{'L', right, codeRight}, std::tuple{'U', down, codeDown}}) {
+        const auto count     = (codeTotal + maxCodeSteps - 1) / maxCodeSteps;
+        const auto steps     = splitEvenly(total, count);
+        const auto codeSteps = splitEvenly(codeTotal, count);
+        for (qint64 i = 0; i < count; ++i)
+            moves << Move{direction, steps[i], codeSteps[i]};
+    }
+
+    static constexpr std::string_view codeDirections = "RDLU";
+    for (const auto &move : moves) {
+        const auto code = QString::number(move.codeSteps, 16).rightJustified(5, '0')
+                          + QString::number(codeDirections.find(move.direction));
+        out << move.direction << ' ' << move.steps << " (#" << code << ")\n";
+    }
+}
+
+void day19(QTextStream &out, int scale, QRandomGenerator &random)
+{
+    static constexpr std::string_view letters    = "abcdefghijklmnopqrstuvwxyz";
+    static constexpr std::string_view categories = "xmas";
+
+    // The workflows form a tree below "in", as in the real input, so every
+    // workflow is reached on exactly one path.
+    const int   workflows = 550 * scale;
+    const int   width     = encodedWidth(workflows, letters, 3);
+    QStringList names{QStringLiteral("in")};
+    for (int i = 1; i < workflows; ++i)
+        names << encode(i, width, letters);
+
+    int nextChild = 1;
+    for (int i = 0; i < workflows; ++i) {
+        const int  rules  = random.bounded(1, 4);
+        const auto target = [&](bool force) -> QString {
+            if (nextChild < workflows && (force || chance(random, 60)))
+                return names[nextChild++];
+            return random.bounded(2) == 0 ? QStringLiteral("A") : QStringLiteral("R");
+        };
+
+        out << names[i] << '{';
+        for (int rule = 0; rule < rules; ++rule) {
+            out << pick(categories, random) << (random.bounded(2) == 0 ? '<' : '>') << random.bounded(1, 4001) << ':'
+                << target(false) << ',';
+        }
+        // keep the tree growing while workflows are left
+        out << target(nextChild == i + 1) << "}\n";
+    }
+
+    out << '\n';
+    for (int rating = 0; rating < 200 * scale; ++rating) {
+        out << "{x=" << random.bounded(1, 4001) << ",m=" << random.bounded(1, 4001) << ",a=" << random.bounded(1, 4001)
+            << ",s=" << random.bounded(1, 4001) << "}\n";
+    }
+}
+
+} // namespace suite::generators
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QRandomGenerator>
+#include <QString>
+#include <QTextStream>
+
+// Synthetic puzzle inputs. Scale 1 produces an input of about the size of the
+// real one; line based inputs get scale times the lines and grids scale times
+// the cells (each side grows with the square root), so the input size grows
+// linearly with the scale for every day.
+namespace suite::generators {
+
+using InputGenerator = void (*)(QTextStream &out, int scale, QRandomGenerator &random);
+
+// Writes the input of the given scale to fileName, creating missing directories.
+bool writeInput(InputGenerator generator, const QString &fileName, int scale, quint32 seed);
+
+void day01(QTextStream &out, int scale, QRandomGenerator &random);
+void day02(QTextStream &out, int scale, QRandomGenerator &random);
+void day03(QTextStream &out, int scale, QRandomGenerator &random);
+void day04(QTextStream &out, int scale, QRandomGenerator &random);
+void day05(QTextStream &out, int scale, QRandomGenerator &random);
+void day06(QTextStream &out, int scale, QRandomGenerator &random);
+void day07(QTextStream &out, int scale, QRandomGenerator &random);
+void day08(QTextStream &out, int scale, QRandomGenerator &random);
+void day09(QTextStream &out, int scale, QRandomGenerator &random);
+void day10(QTextStream &out, int scale, QRandomGenerator &random);
+void day11(QTextStream &out, int scale, QRandomGenerator &random);
+void day12(QTextStream &out, int scale, QRandomGenerator &random);
+void day13(QTextStream &out, int scale, QRandomGenerator &random);
+void day14(QTextStream &out, int scale, QRandomGenerator &random);
+void day15(QTextStream &out, int scale, QRandomGenerator &random);
+void day16(QTextStream &out, int scale, QRandomGenerator &random);
+void day17(QTextStream &out, int scale, QRandomGenerator &random);
+void day18(QTextStream &out, int scale, QRandomGenerator &random);
+void day19(QTextStream &out, int scale, QRandomGenerator &random);
+
+} // namespace suite::generators
@@ -0,0 +1,180 @@
+#include "allocstats.h"
+#include "utils.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+#include <ranges>
+
+namespace {
+
+// The eager helpers utils.h had before the lazy views, kept as the baseline.
+namespace eager {
+
+template<typename T, typename U>
+QVector<std::pair<T, U>> zip(const QVector<T> &v1, const QVector<U> &v2)
+{
+    QVector<std::pair<T, U>> result;
+    const auto               size = std::min(v1.size(), v2.size());
+    result.reserve(size);
+    for (qsizetype i = 0; i < size; ++i)
+        result.append({v1[i], v2[i]});
+    return result;
+}
+
+QVector<std::pair<QChar, QChar>> zip(const QString &v1, const QString &v2)
+{
+    QVector<std::pair<QChar, QChar>> result;
+    const auto                       size = std::min(v1.size(), v2.size());
+    result.reserve(size);
+    for (qsizetype i = 0; i < size; ++i)
+        result.append({v1[i], v2[i]});
+    return result;
+}
+
+} // namespace eager
+
+struct Measurement
+{
+    double nsPerOp          = 0;
+    double allocationsPerOp = 0;
+};
+
+// sink for the results, so the compiler cannot drop the measured work
+qint64 checksum = 0;
+
+template<typename Fn>
+Measurement measure(int iterations, Fn &&fn)
+{
+    // counted by the allocation hooks of suite/allochooks.cpp
+    const auto    allocationsBefore = utils::allocationStats().allocations;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+        checksum += fn();
+    const auto elapsed = timer.nsecsElapsed();
+    return {static_cast<double>(elapsed) / iterations,
+            static_cast<double>(utils::allocationStats().allocations - allocationsBefore) / iterations};
+}
+
+void report(const char *name, const Measurement &before, const Measurement &after)
+{
+    qInfo().noquote() << QStringLiteral("%1  eager %2 ns/op %3 allocs/op  lazy %4 ns/op %5 allocs/op")
+                             .arg(QLatin1String(name), -14)
+                             .arg(before.nsPerOp, 9, 'f', 1)
+                             .arg(before.allocationsPerOp, 6, 'f', 2)
+                             .arg(after.nsPerOp, 9, 'f', 1)
+                             .arg(after.allocationsPerOp, 6, 'f', 2);
+}
+
+QString randomRow(QRandomGenerator &random, int width)
+{
+    QString row(width, '.');
+    for (auto &c : row)
+        c = random.bounded(2) ? '#' : '.';
+    return row;
+}
+
+// day13: characters that differ between two rows
+void benchmarkZipStrings(int iterations)
+{
+    QRandomGenerator random(13);
+    const auto       a = randomRow(random, 64);
+    auto             b = a;
+
+    b[17] = b[17] == '#' ? '.' : '#';
+
+    const auto before = measure(iterations, [&] {
+        return std::ranges::count_if(eager::zip(a, b), [](const auto &entry) { return entry.first != entry.second; });
+    });
+    const auto after  = measure(iterations, [&] {
+        return std::ranges::count_if(utils::zip(a, b), [](const auto &entry) { return entry.first != entry.second; });
+    });
+    report("zip strings", before, after);
+}
+
+// day13: rows above a mirror line, nearest first, against the rows below it
+void benchmarkMirror(int iterations)
+{
+    QRandomGenerator random(17);
+    QVector<QString> grid;
+    for (int y = 0; y < 17; ++y)
+        grid.append(randomRow(random, 17));
+
+    const auto before = measure(iterations, [&] {
+        qint64 mirrors = 0;
+        for (int i = 1; i < grid.size(); ++i) {
+            auto above = grid.mid(0, i);
+            std::reverse(above.begin(), above.end());
+            const auto data = eager::zip(above, grid.mid(i));
+            mirrors += std::ranges::all_of(data, [](const auto &entry) { return entry.first == entry.second; });
+        }
+        return mirrors;
+    });
+    const auto after  = measure(iterations, [&] {
+        qint64 mirrors = 0;
+        for (int i = 1; i < grid.size(); ++i) {
+            auto data = utils::zip(grid | std::views::take(i) | std::views::reverse, grid | std::views::drop(i));
+            mirrors += std::ranges::all_of(data, [](const auto &entry) { return entry.first == entry.second; });
+        }
+        return mirrors;
+    });
+    report("mirror", before, after);
+}
+
+// day12: sum and count of the groups after the current one
+void benchmarkSuffixSum(int iterations)
+{
+    const QVector<int> expected{3, 2, 1, 1, 3, 2, 1, 1, 3, 2, 1, 1, 3, 2, 1};
+
+    const auto before = measure(iterations, [&] {
+        qint64 total = 0;
+        for (qsizetype index = 0; index < expected.size(); ++index) {
+            const auto nextExpected = expected.mid(index + 1);
+            total += utils::sum(nextExpected) + nextExpected.size();
+        }
+        return total;
+    });
+    const auto after  = measure(iterations, [&] {
+        qint64 total = 0;
+        for (const auto &[index, contiguous] : utils::enumerate(expected)) {
+            const auto nextExpected = expected | std::views::drop(index + 1);
+            total += utils::sum(nextExpected) + std::ranges::distance(nextExpected);
+        }
+        return total;
+    });
+    report("suffix sum", before, after);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("aoc_micro");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compares the eager and the lazy range helpers of utils.h.");
+    parser.addHelpOption();
+
+    const QCommandLineOption iterationsOption({"n", "iterations"}, "Number of operations per benchmark.", "count",
+                                              "100000");
+    parser.addOption(iterationsOption);
+    parser.process(app);
+
+    if (!utils::allocationsCounted())
+        qWarning() << "The allocations of Qt containers are not counted on this platform";
+
+    const auto iterations = qMax(1, parser.value(iterationsOption).toInt());
+    benchmarkZipStrings(iterations);
+    benchmarkMirror(iterations);
+    benchmarkSuffixSum(iterations);
+    qInfo() << "checksum" << checksum;
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "perfcounters.h"
+
+#include <QDebug>
+#include <QString>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(Q_OS_LINUX)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace suite {
+
+namespace {
+
+void add(std::optional<qint64> &sum, const std::optional<qint64> &value)
+{
+    if (value)
+        sum = sum.value_or(0) + *value;
+}
+
+std::optional<qint64> divided(const std::optional<qint64> &value, int divisor)
+{
+    if (!value || divisor <= 0)
+        return value;
+    return *value / divisor;
+}
+
+void insertCounter(QJsonObject &object, const char *name, const std::optional<qint64> &value, qint64 inputBytes)
+{
+    if (!value)
+        return;
+    const auto key = QString::fromLatin1(name);
+    object[key]    = *value;
+    if (inputBytes > 0)
+        object[key + QStringLiteral("_per_byte")] = static_cast<double>(*value) / static_cast<double>(inputBytes);
+}
+
+#if defined(Q_OS_LINUX)
+struct CounterConfig
+{
+    quint32 type;
+    quint64 config;
+};
+
+constexpr quint64 l1dReadMissConfig =
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+// in the order of PerfCounters::Counter; PERF_COUNT_HW_CACHE_MISSES is the last level cache
+constexpr CounterConfig counterConfigs[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES   },
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    {PERF_TYPE_HW_CACHE, l1dReadMissConfig          },
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int openCounter(const CounterConfig &counter)
+{
+    perf_event_attr attr{};
+    attr.size           = sizeof(attr);
+    attr.type           = counter.type;
+    attr.config         = counter.config;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    // also count the threads started later, i.e. the workers of the task pool
+    attr.inherit = 1;
+    // scaled by enabled / running time if the PMU multiplexes the counters
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+std::optional<qint64> readCounter(int fd)
+{
+    if (fd < 0)
+        return {};
+    quint64 values[3] = {}; // value, time enabled, time running
+    if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0)
+        return {};
+    if (values[1] == values[2])
+        return static_cast<qint64>(values[0]);
+    return static_cast<qint64>(static_cast<double>(values[0]) * values[1] / values[2]);
+}
+#endif
+
+} // namespace
+
+HardwareCounters &HardwareCounters::operator+=(const HardwareCounters &other)
+{
+    add(cycles, other.cycles);
+    add(instructions, other.instructions);
+    add(l1dReadMisses, other.l1dReadMisses);
+    add(llcMisses, other.llcMisses);
+    add(branchMisses, other.branchMisses);
+    return *this;
+}
+
+HardwareCounters HardwareCounters::averaged(int runs) const
+{
+    return {divided(cycles, runs),
+            divided(instructions, runs),
+            divided(l1dReadMisses, runs),
+            divided(llcMisses, runs),
+            divided(branchMisses, runs)};
+}
+
+QJsonObject HardwareCounters::toJson(qint64 inputBytes) const
+{
+    QJsonObject result{
+        {"input_bytes", inputBytes},
+    };
+    insertCounter(result, "cycles", cycles, 0);
+    insertCounter(result, "instructions", instructions, inputBytes);
+    insertCounter(result, "l1d_read_misses", l1dReadMisses, inputBytes);
+    insertCounter(result, "llc_misses", llcMisses, inputBytes);
+    insertCounter(result, "branch_misses", branchMisses, inputBytes);
+    if (cycles && instructions && *cycles > 0)
+        result["ipc"] = static_cast<double>(*instructions) / static_cast<double>(*cycles);
+    return result;
+}
+
+PerfCounters::PerfCounters()
+{
+    _fds.fill(-1);
+#if defined(Q_OS_LINUX)
+    for (int i = 0; i < CounterCount; ++i)
+        _fds[i] = openCounter(counterConfigs[i]);
+
+    if (!isAvailable()) {
+        static bool warned = false;
+        if (!std::exchange(warned, true))
+            qWarning() << "Hardware counters are not available:" << std::strerror(errno);
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#if defined(Q_OS_LINUX)
+    for (const auto fd : _fds) {
+        if (fd >= 0)
+            close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const
+{
+    return std::ranges::any_of(_fds, [](int fd) { return fd >= 0; });
+}
+
+void PerfCounters::start()
+{
+#if defined(Q_OS_LINUX)
+    for (const auto fd : _fds) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+HardwareCounters PerfCounters::stop()
+{
+#if defined(Q_OS_LINUX)
+    for (const auto fd : _fds) {
+        if (fd >= 0)
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    return {readCounter(_fds[Cycles]),
+            readCounter(_fds[Instructions]),
+            readCounter(_fds[L1dReadMisses]),
+            readCounter(_fds[LlcMisses]),
+            readCounter(_fds[BranchMisses])};
+#else
+    return {};
+#endif
+}
+
+} // namespace suite
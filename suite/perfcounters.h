@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QtGlobal>
+
+#include <array>
+#include <optional>
+
+namespace suite {
+
+// Hardware counters of one measured run, a counter is empty if the CPU or the
+// kernel does not provide it.
+struct HardwareCounters
+{
+    std::optional<qint64> cycles;
+    std::optional<qint64> instructions;
+    std::optional<qint64> l1dReadMisses;
+    std::optional<qint64> llcMisses;
+    std::optional<qint64> branchMisses;
+
+    HardwareCounters &operator+=(const HardwareCounters &other);
+
+    // every counter divided by runs
+    [[nodiscard]] HardwareCounters averaged(int runs) const;
+
+    // the counters plus instructions per cycle and misses per input byte
+    [[nodiscard]] QJsonObject toJson(qint64 inputBytes) const;
+};
+
+// Linux perf_event counters of the calling thread and of the threads it starts
+// afterwards. Construct them before utils::TaskPool::instance() starts its
+// workers, otherwise the counts of parallel days only cover the share of the
+// calling thread. Where perf events are not permitted, e.g. with a high
+// kernel.perf_event_paranoid or in containers, isAvailable() is false.
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    Q_DISABLE_COPY_MOVE(PerfCounters)
+
+    [[nodiscard]] bool isAvailable() const;
+
+    void start();
+
+    HardwareCounters stop();
+
+private:
+    enum Counter { Cycles, Instructions, L1dReadMisses, LlcMisses, BranchMisses, CounterCount };
+
+    std::array<int, CounterCount> _fds;
+};
+
+} // namespace suite
@@ -8,50 +8,83 @@ def create_day(day):
         os.makedirs(dir_name)
         open(dir_name + "/input.txt", 'a').close()
         open(dir_name + "/input_example.txt", 'a').close()
+        with open(dir_name + "/day" + str(f"{day:02d}") + ".h", 'w') as f:
+            f.write(f"""#pragma once
+
+#include <QString>
+
+namespace day{day:02d} {{
+
+QString part1(const QString &fileName);
+QString part2(const QString &fileName);
+
+}} // namespace day{day:02d}
+""")
         with open(dir_name + "/day" + str(f"{day:02d}") + ".cpp", 'w') as f:
-            f.write(f"""#include <QDebug>
+            f.write(f"""#include "day{day:02d}.h"
+
+#include <QDebug>
 #include <QFile>
 #include <QString>
 #include <QVector>
 
 namespace day{day:02d} {{
 
-QString part1(const QString& fileName) 
+QString part1(const QString &fileName)
 {{
     return {{}};
 }}
 
-QString part2(const QString& fileName) 
+QString part2(const QString &fileName)
 {{
     return {{}};
 }}
 
-}}
+}} // namespace day{day:02d}
+""")
+        with open(dir_name + "/main.cpp", 'w') as f:
+            f.write(f"""#include "day{day:02d}.h"
+
+#include "dayrunner.h"
 
-int main()
+int main(int argc, char *argv[])
 {{
-    qDebug() << "Part 1: " << day{day:02d}::part1(":/input.txt");
-    qDebug() << "Part 2: " << day{day:02d}::part2(":/input.txt");
+    return utils::runDay(argc, argv, day{day:02d}::part1, day{day:02d}::part2);
 }}
-
 """)
         with open(dir_name + "/CMakeLists.txt", 'w') as f:
-            f.write(f"""add_executable(
-        day{day:02d}
+            f.write(f"""qt_add_library(
+        day{day:02d}_lib
+        STATIC
         day{day:02d}.cpp
-        resources.qrc
+        day{day:02d}.h
 )
 
 target_include_directories(
-        day{day:02d}
+        day{day:02d}_lib
+        PUBLIC
+        ${{CMAKE_CURRENT_SOURCE_DIR}}
+)
+
+target_link_libraries(
+        day{day:02d}_lib
+        PUBLIC
+        Qt6::Core
         PRIVATE
-        ${{CMAKE_SOURCE_DIR}}/utils
+        utils
+)
+
+qt_add_executable(
+        day{day:02d}
+        main.cpp
+        resources.qrc
 )
 
 target_link_libraries(
         day{day:02d}
         PRIVATE
-        Qt6::Core
+        day{day:02d}_lib
+        utils
 )
 """)
         with open(dir_name + "/resources.qrc", 'w') as f:
@@ -63,6 +96,7 @@ target_link_libraries(
 </RCC>
 """)
         print("Created directory: " + dir_name)
+        print("Remember to add it to CMakeLists.txt and suite/days.cpp")
 
 
 if __name__ == "__main__":
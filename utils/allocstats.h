@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(Q_OS_LINUX)
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+namespace utils {
+
+// Allocation accounting of the probes is only compiled in with
+// -DAOC_ALLOC_STATS=ON. The counters are fed by the replaced allocation
+// functions of suite/allochooks.cpp, so they stay zero in executables without
+// it.
+#ifdef AOC_ALLOC_STATS
+inline constexpr bool allocStatsEnabled = true;
+#else
+inline constexpr bool allocStatsEnabled = false;
+#endif
+
+struct AllocationStats
+{
+    qint64 allocations = 0;
+    qint64 bytes       = 0;
+
+    AllocationStats operator-(const AllocationStats &other) const
+    {
+        return {allocations - other.allocations, bytes - other.bytes};
+    }
+
+    AllocationStats &operator+=(const AllocationStats &other)
+    {
+        allocations += other.allocations;
+        bytes += other.bytes;
+        return *this;
+    }
+};
+
+namespace detail {
+inline std::atomic<qint64> allocationCount{0};
+inline std::atomic<qint64> allocatedBytes{0};
+} // namespace detail
+
+inline void countAllocation(std::size_t size)
+{
+    detail::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    detail::allocatedBytes.fetch_add(static_cast<qint64>(size), std::memory_order_relaxed);
+}
+
+// Allocations of the whole process so far, the difference of two calls is
+// what happened in between on all threads.
+inline AllocationStats allocationStats()
+{
+    return {detail::allocationCount.load(std::memory_order_relaxed),
+            detail::allocatedBytes.load(std::memory_order_relaxed)};
+}
+
+// Whether the allocations of Qt's containers are counted. They go through
+// malloc() rather than operator new, which only the hooks for glibc replace.
+inline bool allocationsCounted()
+{
+    const auto   before = allocationStats();
+    QVector<int> probe(1000);
+    return probe.size() == 1000 && allocationStats().allocations > before.allocations;
+}
+
+// Starts a new peak for peakRss(). Only Linux can reset the peak, elsewhere
+// peakRss() is the peak of the whole process.
+inline void resetPeakRss()
+{
+#if defined(Q_OS_LINUX)
+    QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+    if (clearRefs.open(QIODevice::WriteOnly))
+        clearRefs.write("5");
+#endif
+}
+
+// peak resident set size of the process in bytes, 0 if unknown
+inline qint64 peakRss()
+{
+#if defined(Q_OS_LINUX)
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly))
+        return 0;
+    for (const auto &line : status.readAll().split('\n')) {
+        // "VmHWM:     1234 kB"
+        if (line.startsWith("VmHWM:"))
+            return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+    }
+    return 0;
+#elif defined(Q_OS_UNIX)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(Q_OS_DARWIN)
+    return static_cast<qint64>(usage.ru_maxrss);
+#else
+    return static_cast<qint64>(usage.ru_maxrss) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
+} // namespace utils
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace utils {
+
+using ArenaAllocator = std::pmr::polymorphic_allocator<>;
+
+// std::vector whose storage comes from an Arena
+template<typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+// Monotonic allocator for the state of a single run. Deallocation is a no-op,
+// everything is freed at once by release() or when the arena is destroyed.
+// The first capacity bytes are owned by the arena and reused after release(),
+// only allocations beyond them reach the heap.
+class Arena
+{
+public:
+    static constexpr std::size_t defaultCapacity = 64 * 1024;
+
+    explicit Arena(std::size_t capacity = defaultCapacity)
+        : _capacity(qMax<std::size_t>(capacity, 1))
+        , _buffer(std::make_unique_for_overwrite<std::byte[]>(_capacity))
+        , _resource(_buffer.get(), _capacity)
+    {
+    }
+
+    Q_DISABLE_COPY_MOVE(Arena)
+
+    [[nodiscard]] std::pmr::memory_resource *resource() { return &_resource; }
+
+    [[nodiscard]] ArenaAllocator allocator() { return &_resource; }
+
+    // invalidates every container still using the arena
+    void release() { _resource.release(); }
+
+private:
+    std::size_t                         _capacity;
+    std::unique_ptr<std::byte[]>        _buffer;
+    std::pmr::monotonic_buffer_resource _resource;
+};
+
+} // namespace utils
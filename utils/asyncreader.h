@@ -0,0 +1,540 @@
+#pragma once
+
+#include <QDebug>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#endif
+
+namespace utils {
+
+#if defined(Q_OS_LINUX)
+namespace detail {
+
+// Just enough of io_uring on the raw system calls for reading files. Reads are
+// submitted one at a time and all calls come from the same thread, so the
+// rings need no locking; the kernel is the only other side.
+class IoUring
+{
+public:
+    explicit IoUring(unsigned entries)
+    {
+        io_uring_params params{};
+        _fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (_fd < 0)
+            return;
+
+        _sqSize = params.sq_off.array + params.sq_entries * sizeof(__u32);
+        _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        // both rings share one mapping on kernels since 5.4
+        const bool singleMapping = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMapping)
+            _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+        _sq   = map(_sqSize, IORING_OFF_SQ_RING);
+        _cq   = singleMapping ? _sq : map(_cqSize, IORING_OFF_CQ_RING);
+        _sqes = static_cast<io_uring_sqe *>(map(_sqesSize, IORING_OFF_SQES));
+        if (!_sq || !_cq || !_sqes) {
+            release();
+            return;
+        }
+
+        auto *sq = static_cast<char *>(_sq);
+        _sqHead  = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        _sqTail  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        _sqMask  = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        _sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+        auto *cq = static_cast<char *>(_cq);
+        _cqHead  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        _cqTail  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        _cqMask  = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        _cqes    = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    }
+
+    ~IoUring() { release(); }
+
+    Q_DISABLE_COPY_MOVE(IoUring)
+
+    [[nodiscard]] bool isValid() const { return _fd >= 0; }
+
+    // Pins the buffers, so that the kernel does not map them for every read.
+    // Fails if they exceed RLIMIT_MEMLOCK.
+    bool registerBuffers(const std::vector<iovec> &buffers)
+    {
+        return syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS, buffers.data(), buffers.size()) == 0;
+    }
+
+    // Submits a read of size bytes at offset of fd into buffer. bufferIndex is
+    // the registered buffer that buffer lies in, -1 if none is registered.
+    // Returns false if the kernel did not take the read, which is then
+    // withdrawn, so that it cannot be submitted by a later call.
+    bool read(int fd, char *buffer, unsigned size, quint64 offset, int bufferIndex, quint64 userData)
+    {
+        const auto tail  = *_sqTail;
+        const auto index = tail & _sqMask;
+        auto      &sqe   = _sqes[index];
+        sqe              = {};
+        sqe.opcode       = bufferIndex >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        sqe.fd           = fd;
+        sqe.off          = offset;
+        sqe.addr         = reinterpret_cast<quint64>(buffer);
+        sqe.len          = size;
+        sqe.buf_index    = static_cast<__u16>(std::max(bufferIndex, 0));
+        sqe.user_data    = userData;
+        _sqArray[index]  = index;
+        std::atomic_ref(*_sqTail).store(tail + 1, std::memory_order_release);
+        if (enter(1, 0, 0) == 1)
+            return true;
+        // Without SQPOLL the kernel only consumes entries in io_uring_enter(),
+        // which runs on this thread, so the tail can be taken back safely.
+        if (std::atomic_ref(*_sqHead).load(std::memory_order_acquire) != tail)
+            return true;
+        std::atomic_ref(*_sqTail).store(tail, std::memory_order_release);
+        return false;
+    }
+
+    // Waits for at least one completion and calls handle(userData, result)
+    // for every one that is available.
+    template<typename Handle>
+    bool reap(Handle &&handle)
+    {
+        auto       head  = *_cqHead;
+        const bool empty = head == std::atomic_ref(*_cqTail).load(std::memory_order_acquire);
+        if (empty && enter(0, 1, IORING_ENTER_GETEVENTS) < 0)
+            return false;
+
+        const auto tail = std::atomic_ref(*_cqTail).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            const auto &cqe = _cqes[head & _cqMask];
+            handle(cqe.user_data, cqe.res);
+        }
+        std::atomic_ref(*_cqHead).store(head, std::memory_order_release);
+        return true;
+    }
+
+private:
+    void *map(std::size_t size, quint64 offset) const
+    {
+        auto *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd,
+                             static_cast<off_t>(offset));
+        return address == MAP_FAILED ? nullptr : address;
+    }
+
+    int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) const
+    {
+        for (;;) {
+            const auto result = syscall(__NR_io_uring_enter, _fd, toSubmit, minComplete, flags, nullptr, 0);
+            if (result >= 0 || errno != EINTR)
+                return static_cast<int>(result);
+        }
+    }
+
+    void release()
+    {
+        if (_sqes)
+            munmap(_sqes, _sqesSize);
+        if (_cq && _cq != _sq)
+            munmap(_cq, _cqSize);
+        if (_sq)
+            munmap(_sq, _sqSize);
+        _sq   = nullptr;
+        _cq   = nullptr;
+        _sqes = nullptr;
+        if (_fd >= 0)
+            close(_fd);
+        _fd = -1;
+    }
+
+    int           _fd       = -1;
+    void         *_sq       = nullptr;
+    void         *_cq       = nullptr;
+    io_uring_sqe *_sqes     = nullptr;
+    std::size_t   _sqSize   = 0;
+    std::size_t   _cqSize   = 0;
+    std::size_t   _sqesSize = 0;
+    unsigned     *_sqHead   = nullptr;
+    unsigned     *_sqTail   = nullptr;
+    unsigned     *_sqArray  = nullptr;
+    unsigned      _sqMask   = 0;
+    unsigned     *_cqHead   = nullptr;
+    unsigned     *_cqTail   = nullptr;
+    unsigned      _cqMask   = 0;
+    io_uring_cqe *_cqes     = nullptr;
+};
+
+} // namespace detail
+#endif
+
+// Reads whole input files ahead of their use, so that reading the next files
+// overlaps with solving the current ones. Every file in flight owns one of
+// depth buffers: on Linux the reads are submitted to an io_uring as soon as a
+// buffer is free, into buffers registered with the kernel once. A file larger
+// than bufferSize is read into a buffer of its own instead, which is freed
+// with the File. Without io_uring (other systems, old kernels, seccomp filters
+// in containers) next() reads the file synchronously instead.
+//
+// Files are handed out in order by next() and keep their buffer until the
+// File is destroyed, which may happen on any thread; next() waits while all
+// buffers are taken. Files must not outlive the reader.
+//
+// Only the batch mode of the day executables reads through it, see
+// detail::runBatch(). Single inputs are memory mapped or streamed by the days.
+class AsyncFileReader
+{
+public:
+    static constexpr std::size_t defaultBufferSize = 1024 * 1024;
+    // larger files are not read ahead
+    static constexpr std::size_t maxFileSize = std::size_t{1} << 30;
+
+    class File
+    {
+    public:
+        File(File &&other) noexcept
+            : _reader(std::exchange(other._reader, nullptr))
+            , _slot(other._slot)
+            , _fileName(std::move(other._fileName))
+            , _data(other._data)
+        {}
+
+        File &operator=(File &&) = delete;
+
+        ~File()
+        {
+            if (_reader)
+                _reader->release(_slot);
+        }
+
+        [[nodiscard]] const QString &fileName() const { return _fileName; }
+
+        // The contents, empty if the file was not read ahead because it is
+        // larger than maxFileSize, is no regular file or failed to read. Those
+        // files are left to whoever opens them by name.
+        [[nodiscard]] std::optional<std::string_view> data() const { return _data; }
+
+    private:
+        friend class AsyncFileReader;
+
+        File(AsyncFileReader *reader, std::size_t slot, QString fileName, std::optional<std::string_view> data)
+            : _reader(reader)
+            , _slot(slot)
+            , _fileName(std::move(fileName))
+            , _data(data)
+        {}
+
+        AsyncFileReader                *_reader;
+        std::size_t                     _slot;
+        QString                         _fileName;
+        std::optional<std::string_view> _data;
+    };
+
+    explicit AsyncFileReader(QStringList fileNames, int depth = 8, std::size_t bufferSize = defaultBufferSize)
+        : _fileNames(std::move(fileNames))
+        , _bufferSize(std::clamp<std::size_t>(bufferSize, 1, maxFileSize))
+        , _slots(static_cast<std::size_t>(qMax(depth, 1)))
+#if defined(Q_OS_LINUX)
+        , _ring(static_cast<unsigned>(_slots.size()))
+#endif
+    {
+        for (auto &slot : _slots)
+            slot.buffer = std::make_unique_for_overwrite<char[]>(_bufferSize);
+
+#if defined(Q_OS_LINUX)
+        if (_ring.isValid()) {
+            std::vector<iovec> buffers;
+            for (const auto &slot : _slots)
+                buffers.push_back({slot.buffer.get(), _bufferSize});
+            _registered = _ring.registerBuffers(buffers);
+        }
+#endif
+    }
+
+    ~AsyncFileReader()
+    {
+#if defined(Q_OS_LINUX)
+        // the kernel may still write into the buffers
+        const auto reading = [this] {
+            return std::ranges::any_of(_slots, [](const Slot &slot) { return slot.state == State::Reading; });
+        };
+        while (ringUsable() && reading()) {
+            if (!_ring.reap([this](quint64 slot, int result) { handleCompletion(slot, result); }))
+                abandonRing();
+        }
+        for (auto &slot : _slots)
+            closeFile(slot);
+#endif
+    }
+
+    Q_DISABLE_COPY_MOVE(AsyncFileReader)
+
+    // whether the files are read ahead through io_uring
+    [[nodiscard]] bool isAsynchronous() const
+    {
+#if defined(Q_OS_LINUX)
+        return ringUsable();
+#else
+        return false;
+#endif
+    }
+
+    // The next file once it is read, empty after the last one.
+    std::optional<File> next()
+    {
+        if (_nextFile == _fileNames.size())
+            return {};
+
+        const auto index = static_cast<std::size_t>(_nextFile) % _slots.size();
+        auto      &slot  = _slots[index];
+        submitAhead();
+        if (slot.file != _nextFile) {
+            // the buffer is still held by the file depth places before
+            std::unique_lock lock(_mutex);
+            _released.wait(lock, [&slot] { return slot.state == State::Free; });
+            lock.unlock();
+            submitAhead();
+        }
+
+        while (slot.state == State::Reading)
+            waitForReads(slot);
+
+        {
+            std::lock_guard lock(_mutex);
+            slot.state = State::Held;
+        }
+        std::optional<std::string_view> data;
+        if (slot.hasData)
+            data = std::string_view(slot.data(), slot.done);
+        return File(this, index, _fileNames.at(_nextFile++), data);
+    }
+
+private:
+    enum class State { Free, Reading, Ready, Held };
+
+    struct Slot
+    {
+        std::unique_ptr<char[]> buffer;
+        // the file when it does not fit into buffer
+        std::unique_ptr<char[]> largeBuffer;
+        State                   state    = State::Free;
+        qsizetype               file     = -1;
+        int                     fd       = -1;
+        std::size_t             size     = 0;
+        std::size_t             done     = 0;
+        bool                    hasData  = false;
+        bool                    inFlight = false;
+
+        [[nodiscard]] char *data() const { return largeBuffer ? largeBuffer.get() : buffer.get(); }
+    };
+
+    void release(std::size_t index)
+    {
+        // the slot is held, so the reader does not touch it until it is free
+        _slots[index].largeBuffer.reset();
+        {
+            std::lock_guard lock(_mutex);
+            _slots[index].state = State::Free;
+        }
+        _released.notify_one();
+    }
+
+    // starts reading the files after the current one, as far as buffers are free
+    void submitAhead()
+    {
+        const auto last = std::min(_fileNames.size(), _nextFile + static_cast<qsizetype>(_slots.size()));
+        for (; _nextSubmit < last; ++_nextSubmit) {
+            auto &slot = _slots[static_cast<std::size_t>(_nextSubmit) % _slots.size()];
+            {
+                std::lock_guard lock(_mutex);
+                if (slot.state != State::Free)
+                    return;
+                slot.state = State::Reading;
+            }
+            slot.file    = _nextSubmit;
+            slot.size    = 0;
+            slot.done    = 0;
+            slot.hasData = false;
+            openFile(slot);
+        }
+    }
+
+    void finish(Slot &slot, bool hasData)
+    {
+        closeFile(slot);
+        slot.hasData = hasData;
+        std::lock_guard lock(_mutex);
+        slot.state = State::Ready;
+    }
+
+#if defined(Q_OS_LINUX)
+    void openFile(Slot &slot)
+    {
+        const auto  name = QFile::encodeName(_fileNames.at(slot.file));
+        struct stat info;
+        slot.fd = open(name.constData(), O_RDONLY | O_CLOEXEC);
+        if (slot.fd < 0 || fstat(slot.fd, &info) != 0 || !S_ISREG(info.st_mode)
+            || static_cast<std::size_t>(info.st_size) > maxFileSize) {
+            finish(slot, false);
+            return;
+        }
+        slot.size = static_cast<std::size_t>(info.st_size);
+        if (slot.size > _bufferSize)
+            slot.largeBuffer = std::make_unique_for_overwrite<char[]>(slot.size);
+        if (slot.size == 0) {
+            finish(slot, true);
+            return;
+        }
+        if (ringUsable())
+            submitRead(slot);
+    }
+
+    void closeFile(Slot &slot)
+    {
+        if (slot.fd >= 0)
+            close(slot.fd);
+        slot.fd = -1;
+    }
+
+    void submitRead(Slot &slot)
+    {
+        const auto index = static_cast<std::size_t>(&slot - _slots.data());
+        // only the regular buffers are registered
+        const auto bufferIndex = _registered && !slot.largeBuffer ? static_cast<int>(index) : -1;
+        if (_ring.read(slot.fd, slot.data() + slot.done, static_cast<unsigned>(slot.size - slot.done), slot.done,
+                       bufferIndex, index)) {
+            slot.inFlight = true;
+            return;
+        }
+        // the read was withdrawn, nothing else writes into the buffer
+        qWarning() << "io_uring submission failed, reading" << _fileNames.at(slot.file) << "synchronously";
+        readSynchronously(slot);
+    }
+
+    void handleCompletion(quint64 index, int result)
+    {
+        auto &slot    = _slots[static_cast<std::size_t>(index)];
+        slot.inFlight = false;
+        if (result == -EINTR || result == -EAGAIN) {
+            submitRead(slot);
+        } else if (result < 0) {
+            finish(slot, false);
+        } else {
+            slot.done += static_cast<std::size_t>(result);
+            // a short read continues where it stopped, the end of the file ends early
+            if (result == 0 || slot.done == slot.size)
+                finish(slot, true);
+            else
+                submitRead(slot);
+        }
+    }
+
+    void waitForReads(Slot &slot)
+    {
+        if (!ringUsable()) {
+            readSynchronously(slot);
+            return;
+        }
+        if (!_ring.reap([this](quint64 index, int result) { handleCompletion(index, result); })) {
+            qWarning() << "io_uring wait failed, reading the remaining files synchronously";
+            abandonRing();
+        }
+    }
+
+    [[nodiscard]] bool ringUsable() const { return _ring.isValid() && !_ringFailed; }
+
+    // Stops using the ring once its completions cannot be reaped. The kernel
+    // may still write into the buffers of the pending reads, so those buffers
+    // are leaked rather than reused or freed, and the slots read their files
+    // again into new ones.
+    void abandonRing()
+    {
+        _ringFailed = true;
+        for (auto &slot : _slots) {
+            if (!slot.inFlight)
+                continue;
+            if (slot.largeBuffer) {
+                static_cast<void>(slot.largeBuffer.release());
+                slot.largeBuffer = std::make_unique_for_overwrite<char[]>(slot.size);
+            } else {
+                static_cast<void>(slot.buffer.release());
+                slot.buffer = std::make_unique_for_overwrite<char[]>(_bufferSize);
+            }
+            slot.done     = 0;
+            slot.inFlight = false;
+        }
+    }
+
+    void readSynchronously(Slot &slot)
+    {
+        while (slot.done < slot.size) {
+            const auto result = pread(slot.fd, slot.data() + slot.done, slot.size - slot.done,
+                                      static_cast<off_t>(slot.done));
+            if (result < 0 && errno == EINTR)
+                continue;
+            if (result <= 0) {
+                finish(slot, result == 0);
+                return;
+            }
+            slot.done += static_cast<std::size_t>(result);
+        }
+        finish(slot, true);
+    }
+#else
+    void openFile(Slot &) {}
+
+    void closeFile(Slot &) {}
+
+    void waitForReads(Slot &slot)
+    {
+        QFile file(_fileNames.at(slot.file));
+        if (!file.open(QIODevice::ReadOnly) || file.isSequential()
+            || static_cast<std::size_t>(file.size()) > maxFileSize) {
+            finish(slot, false);
+            return;
+        }
+        if (static_cast<std::size_t>(file.size()) > _bufferSize)
+            slot.largeBuffer = std::make_unique_for_overwrite<char[]>(static_cast<std::size_t>(file.size()));
+        const auto read = file.read(slot.data(), file.size());
+        slot.done       = static_cast<std::size_t>(qMax<qint64>(read, 0));
+        finish(slot, read == file.size());
+    }
+#endif
+
+    QStringList _fileNames;
+    std::size_t _bufferSize;
+    qsizetype   _nextFile   = 0;
+    qsizetype   _nextSubmit = 0;
+
+    std::vector<Slot>       _slots;
+    std::mutex              _mutex;
+    std::condition_variable _released;
+#if defined(Q_OS_LINUX)
+    detail::IoUring _ring;
+    bool            _registered = false;
+    bool            _ringFailed = false;
+#endif
+};
+
+} // namespace utils
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "asyncreader.h"
+#include "incremental.h"
+#include "mappedinput.h"
+#include "taskpool.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <cstddef>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace utils {
+
+using PartFunction = QString (*)(const QString &fileName);
+
+namespace detail {
+
+// Input files of a batch: the files of a directory in name order, or the
+// lines of a manifest file, relative to its directory. Empty lines and lines
+// starting with # are skipped.
+inline std::optional<QStringList> batchFiles(const QString &path)
+{
+    const QFileInfo info(path);
+    if (info.isDir()) {
+        const QDir  directory(path);
+        QStringList files;
+        for (const auto &name : directory.entryList(QDir::Files, QDir::Name))
+            files.append(directory.filePath(name));
+        return files;
+    }
+
+    QFile manifest(path);
+    if (!manifest.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << "Failed to open file" << path;
+        return {};
+    }
+    const auto  directory = info.dir();
+    QStringList files;
+    while (!manifest.atEnd()) {
+        const auto line = QString::fromUtf8(manifest.readLine()).trimmed();
+        if (!line.isEmpty() && !line.startsWith('#'))
+            files.append(directory.filePath(line));
+    }
+    return files;
+}
+
+// Solves every file of a batch on the shared task pool and writes one tab
+// separated line "<file> <part 1> <part 2>" per file to stdout. The lines are
+// in the order of the batch and written while later files are still solved.
+// The process, the pools and the thread local scratch buffers of the days are
+// set up once for all files, and the inputs are read ahead by an
+// AsyncFileReader. A part that is not run or a file that cannot be read leaves
+// its column empty.
+inline int runBatch(const QString &path, const QString &part, PartFunction part1, PartFunction part2)
+{
+    const auto files = batchFiles(path);
+    if (!files)
+        return 1;
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly))
+        return 1;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<std::optional<QByteArray>> lines(static_cast<std::size_t>(files->size()));
+    std::mutex                             outMutex;
+    std::size_t                            nextLine = 0;
+    std::atomic<qint64>                    bytes{0};
+    std::atomic<int>                       failures{0};
+
+    const auto solve = [&](std::size_t i, const AsyncFileReader::File &file) {
+        const auto &fileName = file.fileName();
+        QString     answer1;
+        QString     answer2;
+        if (const QFileInfo info(fileName); file.data() || info.isFile()) {
+            bytes += file.data() ? static_cast<qint64>(file.data()->size()) : info.size();
+            // the days read the prefetched contents instead of the file
+            std::optional<ProvidedInput> provided;
+            if (file.data())
+                provided.emplace(fileName, *file.data());
+            if (part != "2")
+                answer1 = part1(fileName);
+            if (part != "1")
+                answer2 = part2(fileName);
+        } else {
+            qWarning() << "No such file" << fileName;
+            ++failures;
+        }
+
+        // lines are written in batch order, by whoever completes the next one
+        std::lock_guard lock(outMutex);
+        lines[i] = QStringLiteral("%1\t%2\t%3\n").arg(fileName, answer1, answer2).toUtf8();
+        for (; nextLine < lines.size() && lines[nextLine]; ++nextLine) {
+            out.write(*lines[nextLine]);
+            lines[nextLine].reset();
+        }
+        out.flush();
+    };
+
+    // The files are read ahead, two per worker, while the workers solve the
+    // ones before them. The files are pushed rather than run in a TaskGroup,
+    // so that this thread only reads and the workers never nest one file in
+    // the wait of another.
+    auto           &pool = TaskPool::instance();
+    AsyncFileReader reader(*files, 2 * pool.threadCount());
+    std::latch      done(files->size());
+    for (std::size_t i = 0; auto file = reader.next(); ++i) {
+        // shared, since tasks are copied into the pool
+        pool.push([&solve, &done, i, file = std::make_shared<AsyncFileReader::File>(std::move(*file))]() mutable {
+            solve(i, *file);
+            // the slot goes back to the reader before it may be destroyed
+            file.reset();
+            done.count_down();
+        });
+    }
+    done.wait();
+
+    const auto seconds = static_cast<double>(timer.nsecsElapsed()) / 1e9;
+    const auto mb      = static_cast<double>(bytes.load()) / 1e6;
+    qInfo().noquote() << QStringLiteral("%1 files, %2 MB in %3 s: %4 files/s, %5 MB/s")
+                             .arg(files->size())
+                             .arg(mb, 0, 'f', 1)
+                             .arg(seconds, 0, 'f', 3)
+                             .arg(seconds > 0 ? files->size() / seconds : 0.0, 0, 'f', 1)
+                             .arg(seconds > 0 ? mb / seconds : 0.0, 0, 'f', 1);
+    return failures > 0 ? 1 : 0;
+}
+
+} // namespace detail
+
+// Shared main() of the day executables:
+//   dayNN [-p 1|2] [-i dir] [input]
+//   dayNN [-p 1|2] -b dir|manifest
+// input is a file path, "-" for stdin, or the embedded :/input.txt if omitted.
+// With -i, or AOC_INCREMENTAL_DIR set, days that support it keep incremental
+// states in dir and only solve the lines appended to input since the previous
+// run. With -b, all files of a directory or manifest are solved in one
+// process, see detail::runBatch().
+inline int runDay(int argc, char *argv[], PartFunction part1, PartFunction part2)
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Solves the puzzle of the day for the given input.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("input", "Input file, - for stdin. Defaults to the embedded input.", "[input]");
+
+    const QCommandLineOption partOption({"p", "part"}, "Only run <part> (1 or 2).", "part");
+    const QCommandLineOption incrementalOption({"i", "incremental"},
+                                               "Keep solved states in <dir> and only solve appended lines next time. "
+                                               "Defaults to the AOC_INCREMENTAL_DIR environment variable.",
+                                               "dir");
+    const QCommandLineOption batchOption({"b", "batch"},
+                                         "Solve all files of a directory, or listed in a manifest file, one result "
+                                         "line per file.",
+                                         "path");
+    parser.addOptions({partOption, incrementalOption, batchOption});
+    parser.process(app);
+
+    utils::setIncrementalDirectory(parser.isSet(incrementalOption) ? parser.value(incrementalOption)
+                                                                   : qEnvironmentVariable("AOC_INCREMENTAL_DIR"));
+
+    const auto positional = parser.positionalArguments();
+    if (positional.size() > 1 || (parser.isSet(batchOption) && !positional.isEmpty()))
+        parser.showHelp(1);
+    const auto fileName = positional.isEmpty() ? QStringLiteral(":/input.txt") : positional.first();
+
+    const auto part = parser.value(partOption);
+    if (!part.isEmpty() && part != "1" && part != "2") {
+        qWarning() << "Invalid part" << part;
+        return 1;
+    }
+
+    if (parser.isSet(batchOption))
+        return detail::runBatch(parser.value(batchOption), part, part1, part2);
+
+    if (part != "2")
+        qInfo() << "Part 1:" << part1(fileName);
+    if (part != "1")
+        qInfo() << "Part 2:" << part2(fileName);
+    return 0;
+}
+
+} // namespace utils
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <version>
+
+#if defined(__cpp_lib_generator)
+#include <generator>
+#else
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace utils {
+
+#if defined(__cpp_lib_generator)
+template<typename T>
+using Generator = std::generator<T>;
+#else
+// Minimal stand-in for std::generator for standard libraries that do not have
+// it yet: a lazily evaluated, single pass input range of the co_yielded values.
+// A yielded value is only valid until the iterator is incremented.
+template<typename T>
+class Generator : public std::ranges::view_interface<Generator<T>>
+{
+public:
+    struct promise_type
+    {
+        T                  value{};
+        std::exception_ptr exception;
+
+        Generator get_return_object() { return Generator(Handle::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(T yielded) noexcept(std::is_nothrow_move_assignable_v<T>)
+        {
+            value = std::move(yielded);
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        // generators only yield, they cannot co_await
+        template<typename U>
+        std::suspend_never await_transform(U &&) = delete;
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    class Iterator
+    {
+    public:
+        using value_type      = T;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        explicit Iterator(Handle handle)
+            : _handle(handle)
+        {}
+
+        const T &operator*() const { return _handle.promise().value; }
+
+        Iterator &operator++()
+        {
+            _handle.resume();
+            rethrow(_handle);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const Iterator &it, std::default_sentinel_t) { return !it._handle || it._handle.done(); }
+
+    private:
+        Handle _handle;
+    };
+
+    Generator() = default;
+
+    Generator(Generator &&other) noexcept
+        : _handle(std::exchange(other._handle, {}))
+    {}
+
+    Generator &operator=(Generator &&other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+    ~Generator() { destroy(); }
+
+    // runs the coroutine up to its first co_yield, may only be called once
+    Iterator begin()
+    {
+        if (_handle) {
+            _handle.resume();
+            rethrow(_handle);
+        }
+        return Iterator(_handle);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit Generator(Handle handle)
+        : _handle(handle)
+    {}
+
+    static void rethrow(Handle handle)
+    {
+        if (auto exception = std::exchange(handle.promise().exception, {}))
+            std::rethrow_exception(exception);
+    }
+
+    void destroy()
+    {
+        if (_handle)
+            _handle.destroy();
+    }
+
+    Handle _handle;
+};
+#endif
+
+} // namespace utils
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "arena.h"
+#include "stringutils.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace utils {
+
+struct Point
+{
+    int x = 0;
+    int y = 0;
+
+    friend constexpr Point operator+(Point a, Point b) { return {a.x + b.x, a.y + b.y}; }
+    friend constexpr Point operator-(Point a, Point b) { return {a.x - b.x, a.y - b.y}; }
+
+    constexpr auto operator<=>(const Point &) const = default;
+};
+
+// north, east, south, west
+inline constexpr std::array<Point, 4> orthogonalSteps{
+    {{0, -1}, {1, 0}, {0, 1}, {-1, 0}}
+};
+
+// Dense row-major grid of width x height cells. An optional border ring of
+// cells around it can be addressed with coordinates just outside of the grid,
+// so walks that are stopped by a border value need no bounds checks.
+// The cells are a pmr vector and can be allocated from an Arena; T must not be
+// bool since std::vector<bool> has no addressable cells.
+template<typename T>
+class Grid
+{
+public:
+    using value_type = T;
+
+    Grid() = default;
+
+    Grid(int width, int height, const T &value = T{}, int border = 0, ArenaAllocator allocator = {})
+        : _width(width)
+        , _height(height)
+        , _border(border)
+        , _stride(width + 2 * border)
+        , _cells(static_cast<std::size_t>(_stride) * static_cast<std::size_t>(height + 2 * border), value, allocator)
+    {}
+
+    // copy whose cells are allocated from allocator
+    Grid(const Grid &other, ArenaAllocator allocator)
+        : _width(other._width)
+        , _height(other._height)
+        , _border(other._border)
+        , _stride(other._stride)
+        , _cells(other._cells, allocator)
+    {}
+
+    Grid(const Grid &)            = default;
+    Grid(Grid &&)                 = default;
+    Grid &operator=(const Grid &) = default;
+    Grid &operator=(Grid &&)      = default;
+
+    // One row per non-empty line, each character is converted to a cell.
+    // Border cells and cells missing in short lines are set to borderValue.
+    template<std::ranges::forward_range Lines, typename Convert>
+    static Grid fromLines(const Lines   &lines,
+                          Convert      &&convert,
+                          int            border      = 0,
+                          const T       &borderValue = T{},
+                          ArenaAllocator allocator   = {})
+    {
+        int width  = 0;
+        int height = 0;
+        for (const std::string_view line : lines) {
+            if (const auto size = trimmed(line).size(); size > 0) {
+                width = std::max(width, static_cast<int>(size));
+                ++height;
+            }
+        }
+
+        Grid grid(width, height, borderValue, border, allocator);
+        int  y = 0;
+        for (const std::string_view rawLine : lines) {
+            const auto line = trimmed(rawLine);
+            if (line.empty())
+                continue;
+            auto row = grid.row(y++);
+            for (std::size_t x = 0; x < line.size(); ++x)
+                row[x] = convert(line[x]);
+        }
+        return grid;
+    }
+
+    [[nodiscard]] int width() const { return _width; }
+
+    [[nodiscard]] int height() const { return _height; }
+
+    [[nodiscard]] int border() const { return _border; }
+
+    [[nodiscard]] bool isEmpty() const { return _width == 0 || _height == 0; }
+
+    // whether p is inside the grid, border cells are not
+    [[nodiscard]] bool contains(Point p) const { return p.x >= 0 && p.y >= 0 && p.x < _width && p.y < _height; }
+
+    T &operator[](Point p) { return _cells[index(p)]; }
+
+    const T &operator[](Point p) const { return _cells[index(p)]; }
+
+    [[nodiscard]] std::span<T> row(int y) { return {_cells.data() + index({0, y}), static_cast<std::size_t>(_width)}; }
+
+    [[nodiscard]] std::span<const T> row(int y) const
+    {
+        return {_cells.data() + index({0, y}), static_cast<std::size_t>(_width)};
+    }
+
+    [[nodiscard]] auto column(int x)
+    {
+        return std::views::iota(0, _height) | std::views::transform([this, x](int y) -> T & { return (*this)[{x, y}]; });
+    }
+
+    [[nodiscard]] auto column(int x) const
+    {
+        return std::views::iota(0, _height)
+               | std::views::transform([this, x](int y) -> const T & { return (*this)[{x, y}]; });
+    }
+
+    // the orthogonal neighbours of p in the order of orthogonalSteps, they
+    // are only guaranteed to be addressable if p is inside and border > 0
+    [[nodiscard]] static constexpr std::array<Point, 4> neighbours(Point p)
+    {
+        return {p + orthogonalSteps[0], p + orthogonalSteps[1], p + orthogonalSteps[2], p + orthogonalSteps[3]};
+    }
+
+    // all points inside the grid in row-major order
+    [[nodiscard]] auto points() const
+    {
+        const int width = _width;
+        return std::views::iota(0, _width * _height)
+               | std::views::transform([width](int i) { return Point{i % width, i / width}; });
+    }
+
+    [[nodiscard]] std::optional<Point> find(const T &value) const
+    {
+        for (const auto p : points()) {
+            if ((*this)[p] == value)
+                return p;
+        }
+        return {};
+    }
+
+    bool operator==(const Grid &other) const
+    {
+        return _width == other._width && _height == other._height && _border == other._border
+               && _cells == other._cells;
+    }
+
+    // see utils/snapshot.h
+    template<typename Archive>
+    void serialize(Archive &ar)
+    {
+        ar(_width, _height, _border, _stride, _cells);
+        // the cells are indexed unchecked, a corrupt snapshot must not load
+        if constexpr (Archive::isReading) {
+            if (_width < 0 || _height < 0 || _border < 0 || _stride != _width + 2 * _border
+                || _cells.size() != static_cast<std::size_t>(_stride) * static_cast<std::size_t>(_height + 2 * _border))
+                ar.invalidate();
+        }
+    }
+
+private:
+    [[nodiscard]] std::size_t index(Point p) const
+    {
+        Q_ASSERT(p.x >= -_border && p.y >= -_border && p.x < _width + _border && p.y < _height + _border);
+        return static_cast<std::size_t>(p.y + _border) * static_cast<std::size_t>(_stride)
+               + static_cast<std::size_t>(p.x + _border);
+    }
+
+    int                 _width  = 0;
+    int                 _height = 0;
+    int                 _border = 0;
+    int                 _stride = 0;
+    std::pmr::vector<T> _cells;
+};
+
+} // namespace utils
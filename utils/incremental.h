@@ -0,0 +1,165 @@
+#pragma once
+
+#include "snapshot.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHashFunctions>
+#include <QSaveFile>
+#include <QString>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <utility>
+
+namespace utils {
+
+// Incremental solving of inputs that only ever grow by appended lines. A day
+// keeps its running aggregates in a State and folds lines into it with
+//     void update(State &state, std::string_view lines)
+// The state after the last complete line is saved together with its byte
+// offset, and the next run on the same file only folds in the lines appended
+// since then. States are written with the snapshot archives, so a State is
+// trivially copyable or provides serialize().
+
+namespace detail {
+
+// bump when the file layout or the archives change
+inline constexpr quint32 incrementalFormatVersion = 1;
+
+// bytes before the saved offset that must be unchanged for the state to be reused
+inline constexpr std::size_t incrementalCheckSize = 4096;
+
+struct IncrementalHeader
+{
+    std::array<char, 4> magic{'A', 'O', 'C', 'I'};
+    quint32             formatVersion = incrementalFormatVersion;
+    quint32             typeVersion   = 0;
+    quint32             qtVersion     = QT_VERSION;
+    quint64             offset        = 0;
+    quint64             checkHash     = 0;
+
+    bool operator==(const IncrementalHeader &) const = default;
+};
+
+inline QString &incrementalDirectoryStorage()
+{
+    static QString directory;
+    return directory;
+}
+
+// Hash of the bytes just before offset. It only detects rewrites near the end
+// of what was processed, hashing the whole prefix would make every run O(file).
+inline quint64 incrementalCheckHash(std::string_view input, std::size_t offset)
+{
+    const auto size = std::min(offset, incrementalCheckSize);
+    return qHash(QByteArrayView(input.data() + offset - size, static_cast<qsizetype>(size)), 0x5eed0003);
+}
+
+inline void saveIncrementalState(const QString &filePath, const IncrementalHeader &header, const QByteArray &payload)
+{
+    QSaveFile out(filePath);
+    if (!QDir().mkpath(QFileInfo(filePath).path()) || !out.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write incremental state" << filePath;
+        return;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(payload);
+    if (!out.commit())
+        qWarning() << "Failed to write incremental state" << filePath;
+}
+
+} // namespace detail
+
+// Directory of the incremental states, incremental solving is off while it is
+// empty, which is the default. The day executables set it from --incremental
+// or the AOC_INCREMENTAL_DIR environment variable, see runDay(); the suite
+// tools measure full solves and leave it empty.
+inline QString incrementalDirectory()
+{
+    return detail::incrementalDirectoryStorage();
+}
+
+inline void setIncrementalDirectory(const QString &directory)
+{
+    detail::incrementalDirectoryStorage() = directory;
+}
+
+// Returns the state after folding all lines of input, the contents of
+// fileName, into State{}. With an incremental directory, only the lines after
+// the offset saved by the previous run are folded into the saved state. If the
+// file shrank or its processed part was rewritten, everything is folded again.
+// name identifies the state and version must be changed whenever its layout or
+// meaning changes. A last line without a newline may still be growing, so it is
+// folded into the result but not into the saved state. stdin is never saved.
+template<typename State, typename Update>
+State incrementalReduce(const char *name, quint32 version, const QString &fileName, std::string_view input,
+                        Update &&update)
+{
+    State      state{};
+    const auto directory = incrementalDirectory();
+    if (directory.isEmpty() || fileName == QLatin1String("-")) {
+        update(state, input);
+        return state;
+    }
+
+    const auto key      = QFileInfo(fileName).absoluteFilePath();
+    const auto filePath = QDir(directory).filePath(
+        QStringLiteral("%1-%2.state").arg(QLatin1String(name)).arg(qHash(key, 0x5eed0004), 16, 16, QChar('0')));
+
+    detail::IncrementalHeader expected;
+    expected.typeVersion = version;
+
+    std::size_t offset = 0;
+    bool        loaded = false;
+    QFile       file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        const auto data = file.readAll();
+        if (data.size() >= static_cast<qsizetype>(sizeof(expected))) {
+            detail::IncrementalHeader header;
+            std::memcpy(&header, data.constData(), sizeof(header));
+            if (header.offset <= input.size()) {
+                expected.offset    = header.offset;
+                expected.checkHash = detail::incrementalCheckHash(input, header.offset);
+            }
+            if (header == expected) {
+                SnapshotReader reader({data.constData() + sizeof(header), data.size() - sizeof(header)});
+                State          saved{};
+                reader(saved);
+                if (reader.isValid()) {
+                    state  = std::move(saved);
+                    offset = header.offset;
+                    loaded = true;
+                }
+            }
+        }
+    }
+
+    const auto newline  = input.rfind('\n');
+    const auto complete = newline == std::string_view::npos ? 0 : newline + 1;
+    update(state, input.substr(offset, complete - offset));
+
+    if (!loaded || complete != offset) {
+        expected.offset    = complete;
+        expected.checkHash = detail::incrementalCheckHash(input, complete);
+        SnapshotWriter writer;
+        writer(state);
+        detail::saveIncrementalState(filePath, expected, writer.data());
+    }
+
+    if (complete == input.size())
+        return state;
+    auto result = state;
+    update(result, input.substr(complete));
+    return result;
+}
+
+} // namespace utils
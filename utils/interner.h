@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace utils {
+
+// Maps names to dense ids 0, 1, 2, ... in the order they are first seen. Used
+// at parse time, so that the parsed structures refer to each other by index
+// into plain vectors and the solvers never hash or compare strings.
+class Interner
+{
+public:
+    using Id = int;
+
+    static constexpr Id invalid = -1;
+
+    // id of name, a new one if it was not seen before
+    Id intern(std::string_view name)
+    {
+        if (const auto it = _ids.find(name); it != _ids.end())
+            return it->second;
+        const auto id = static_cast<Id>(_names.size());
+        _names.emplace_back(name);
+        _ids.emplace(_names.back(), id);
+        return id;
+    }
+
+    // id of name, invalid if it was never interned
+    [[nodiscard]] Id find(std::string_view name) const
+    {
+        const auto it = _ids.find(name);
+        return it != _ids.end() ? it->second : invalid;
+    }
+
+    [[nodiscard]] std::string_view name(Id id) const { return _names[static_cast<std::size_t>(id)]; }
+
+    [[nodiscard]] qsizetype size() const { return static_cast<qsizetype>(_names.size()); }
+
+private:
+    // transparent, so that lookups with a string_view need no std::string
+    struct Hash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    std::vector<std::string>                                   _names;
+    std::unordered_map<std::string, Id, Hash, std::equal_to<>> _ids;
+};
+
+} // namespace utils
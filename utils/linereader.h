@@ -0,0 +1,121 @@
+#pragma once
+
+#include "generator.h"
+#include "mappedinput.h"
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+namespace utils {
+
+namespace detail {
+
+constexpr std::string_view withoutCarriageReturn(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    return line;
+}
+
+} // namespace detail
+
+// Lines of device, without the line terminator, read chunkSize bytes at a time.
+// Only the current chunk and the incomplete line at its end are kept in memory,
+// so the memory use is bounded by the longest line rather than by the input.
+// A yielded line is only valid until the next one is requested.
+inline Generator<std::string_view> lines(QIODevice &device, qsizetype chunkSize)
+{
+    QByteArray  buffer;
+    std::size_t used = 0;
+    // the carried over incomplete line has no newline, no need to search it again
+    std::size_t searchFrom = 0;
+
+    for (;;) {
+        buffer.resize(static_cast<qsizetype>(used) + chunkSize);
+        const auto read = device.read(buffer.data() + used, chunkSize);
+        if (read > 0)
+            used += static_cast<std::size_t>(read);
+
+        const std::string_view data(buffer.constData(), used);
+        std::size_t            lineStart = 0;
+        auto                   newline   = data.find('\n', searchFrom);
+        while (newline != std::string_view::npos) {
+            co_yield detail::withoutCarriageReturn(data.substr(lineStart, newline - lineStart));
+            lineStart = newline + 1;
+            newline   = data.find('\n', lineStart);
+        }
+
+        if (read < 0)
+            qWarning() << "Failed to read input, stopping early:" << device.errorString();
+        if (read <= 0) {
+            if (lineStart < used)
+                co_yield detail::withoutCarriageReturn(data.substr(lineStart));
+            co_return;
+        }
+
+        used -= lineStart;
+        // the incomplete line may overlap its destination
+        if (lineStart > 0)
+            std::memmove(buffer.data(), buffer.constData() + lineStart, used);
+        searchFrom = used;
+    }
+}
+
+// Lines of text that is already in memory, as a Generator.
+inline Generator<std::string_view> lines(std::string_view text)
+{
+    for (const auto line : Lines(text))
+        co_yield line;
+}
+
+// Single pass, constant memory reader of the lines of an input file, for days
+// that handle each line once. The file name "-" reads standardInput(), which
+// is buffered in full since the other part needs it again; a ProvidedInput is
+// used as is.
+class LineReader
+{
+public:
+    static constexpr qsizetype defaultChunkSize = 64 * 1024;
+
+    explicit LineReader(const QString &fileName, qsizetype chunkSize = defaultChunkSize)
+        : _file(fileName)
+        , _chunkSize(qMax<qsizetype>(chunkSize, 1))
+    {
+        if (fileName == QLatin1String("-")) {
+            const auto &input = standardInput();
+            _text             = std::string_view(input.constData(), static_cast<std::size_t>(input.size()));
+        } else if (const auto provided = ProvidedInput::find(fileName)) {
+            _text = provided;
+        } else if (!_file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Failed to open file" << fileName;
+        }
+    }
+
+    Q_DISABLE_COPY_MOVE(LineReader)
+
+    [[nodiscard]] bool isOpen() const { return _text || _file.isOpen(); }
+
+    // may only be iterated once, the lines are consumed from the file
+    [[nodiscard]] Generator<std::string_view> lines()
+    {
+        if (_text)
+            return utils::lines(*_text);
+        return utils::lines(_file, _chunkSize);
+    }
+
+private:
+    QFile     _file;
+    qsizetype _chunkSize;
+    // text already in memory, read instead of _file
+    std::optional<std::string_view> _text;
+};
+
+} // namespace utils
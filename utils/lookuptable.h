@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+
+namespace detail {
+
+// number of distinct keys of a byte sized key type, 0 for other types
+template<typename Key>
+constexpr std::size_t byteKeyCount()
+{
+    if constexpr (std::is_integral_v<Key> && sizeof(Key) == 1)
+        return 256;
+    else
+        return 0;
+}
+
+} // namespace detail
+
+// Fixed table from small keys to values that is indexed by the key itself, so
+// a lookup is a single load instead of a tree walk or hashing. Keys are chars,
+// which use all 256 entries, or enums whose values are below Size. Tables are
+// meant to be constexpr, built from {key, value} pairs or with insert() in a
+// constexpr function. Keys that were not inserted map to the fallback value.
+template<typename Key, typename Value, std::size_t Size = detail::byteKeyCount<Key>()>
+class LookupTable
+{
+    static_assert(std::is_enum_v<Key> || detail::byteKeyCount<Key>() > 0, "keys must be chars or enums");
+    static_assert(Size > 0, "enum keys need the table size");
+
+public:
+    constexpr explicit LookupTable(Value fallback = Value{}) { _values.fill(fallback); }
+
+    constexpr LookupTable(std::initializer_list<std::pair<Key, Value>> entries, Value fallback = Value{})
+        : LookupTable(fallback)
+    {
+        for (const auto &[key, value] : entries)
+            insert(key, value);
+    }
+
+    constexpr void insert(Key key, Value value)
+    {
+        _values[index(key)]  = std::move(value);
+        _present[index(key)] = true;
+    }
+
+    [[nodiscard]] constexpr const Value &operator[](Key key) const { return _values[index(key)]; }
+
+    [[nodiscard]] constexpr bool contains(Key key) const { return _present[index(key)]; }
+
+private:
+    static constexpr std::size_t index(Key key)
+    {
+        std::size_t result = 0;
+        if constexpr (std::is_enum_v<Key>)
+            result = static_cast<std::size_t>(std::to_underlying(key));
+        else
+            result = static_cast<std::make_unsigned_t<Key>>(key);
+        Q_ASSERT(result < Size);
+        return result;
+    }
+
+    std::array<Value, Size> _values{};
+    std::array<bool, Size>  _present{};
+};
+
+} // namespace utils
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDebug>
+#include <QFile>
+#include <QString>
+
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+namespace utils {
+
+// Iterates the lines of a buffer as views into it, without the line terminator.
+class LineIterator
+{
+public:
+    using iterator_concept  = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::string_view *;
+    using reference         = std::string_view;
+
+    LineIterator() = default;
+
+    explicit LineIterator(std::string_view text)
+        : _rest(text)
+        , _done(false)
+    {
+        advance();
+    }
+
+    std::string_view operator*() const { return _line; }
+
+    LineIterator &operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    LineIterator operator++(int)
+    {
+        auto copy = *this;
+        advance();
+        return copy;
+    }
+
+    bool operator==(const LineIterator &other) const
+    {
+        return _done == other._done && (_done || _line.data() == other._line.data());
+    }
+
+private:
+    void advance()
+    {
+        if (_rest.empty()) {
+            _done = true;
+            _line = {};
+            return;
+        }
+
+        const auto newline = _rest.find('\n');
+        if (newline == std::string_view::npos) {
+            _line = _rest;
+            _rest = {};
+        } else {
+            _line = _rest.substr(0, newline);
+            _rest.remove_prefix(newline + 1);
+        }
+
+        if (!_line.empty() && _line.back() == '\r')
+            _line.remove_suffix(1);
+    }
+
+    std::string_view _rest;
+    std::string_view _line;
+    bool             _done = true;
+};
+
+class Lines : public std::ranges::view_interface<Lines>
+{
+public:
+    Lines() = default;
+
+    explicit Lines(std::string_view text)
+        : _text(text)
+    {}
+
+    [[nodiscard]] LineIterator begin() const { return LineIterator(_text); }
+
+    [[nodiscard]] LineIterator end() const { return {}; }
+
+private:
+    std::string_view _text;
+};
+
+// The whole of stdin. It is read on first use and then shared, so that both
+// parts of a day can run on a pipe.
+inline const QByteArray &standardInput()
+{
+    static const QByteArray input = [] {
+        QFile in;
+        if (!in.open(stdin, QIODevice::ReadOnly)) {
+            qWarning() << "Failed to open stdin";
+            return QByteArray();
+        }
+        return in.readAll();
+    }();
+    return input;
+}
+
+// Contents of an input file that the caller already has in memory, e.g. from
+// an AsyncFileReader. While one is alive, MappedInput and LineReader of that
+// file name on the same thread use its data instead of reading the file. They
+// nest, the innermost one of a file name wins.
+class ProvidedInput
+{
+public:
+    ProvidedInput(const QString &fileName, std::string_view data)
+        : _fileName(fileName)
+        , _data(data)
+        , _outer(std::exchange(current, this))
+    {}
+
+    ~ProvidedInput() { current = _outer; }
+
+    Q_DISABLE_COPY_MOVE(ProvidedInput)
+
+    // data provided for fileName on this thread, if any
+    static std::optional<std::string_view> find(const QString &fileName)
+    {
+        for (const auto *input = current; input; input = input->_outer) {
+            if (input->_fileName == fileName)
+                return input->_data;
+        }
+        return {};
+    }
+
+private:
+    static inline thread_local const ProvidedInput *current = nullptr;
+
+    QString              _fileName;
+    std::string_view     _data;
+    const ProvidedInput *_outer;
+};
+
+// Read-only view of a whole input file. Regular files are memory mapped, so
+// iterating the lines neither copies nor allocates; devices that cannot be
+// mapped (compressed resources, pipes) are read into a single buffer instead.
+// All views handed out stay valid as long as the MappedInput is alive.
+// The file name "-" reads standardInput(), a ProvidedInput is used as is.
+class MappedInput
+{
+public:
+    explicit MappedInput(const QString &fileName)
+        : _file(fileName)
+    {
+        if (fileName == QLatin1String("-")) {
+            const auto &input = standardInput();
+            _data             = {input.constData(), static_cast<std::size_t>(input.size())};
+            _isBorrowed       = true;
+            return;
+        }
+        if (const auto provided = ProvidedInput::find(fileName)) {
+            _data       = *provided;
+            _isBorrowed = true;
+            return;
+        }
+
+        if (!_file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Failed to open file" << fileName;
+            return;
+        }
+
+        if (const auto size = _file.size(); size > 0 && !_file.isSequential()) {
+            if (const auto *mapped = _file.map(0, size)) {
+                _data = {reinterpret_cast<const char *>(mapped), static_cast<std::size_t>(size)};
+                return;
+            }
+        }
+
+        _buffer = _file.readAll();
+        _data   = {_buffer.constData(), static_cast<std::size_t>(_buffer.size())};
+    }
+
+    Q_DISABLE_COPY_MOVE(MappedInput)
+
+    [[nodiscard]] bool isOpen() const { return _isBorrowed || _file.isOpen(); }
+
+    [[nodiscard]] std::string_view data() const { return _data; }
+
+    [[nodiscard]] std::size_t size() const { return _data.size(); }
+
+    [[nodiscard]] Lines lines() const { return Lines(_data); }
+
+private:
+    QFile            _file;
+    QByteArray       _buffer;
+    std::string_view _data;
+    // _data is owned elsewhere, by standardInput() or a ProvidedInput
+    bool _isBorrowed = false;
+};
+
+} // namespace utils
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace utils {
+
+namespace detail {
+
+// Finds digits a block at a time: bit i of a block mask is set if byte i of
+// the block is a decimal digit. Builds with AVX2 classify 32 bytes at once,
+// plain x86-64 builds 16 bytes with SSE2, everything else falls back to a
+// byte-wise scan (blockSize 0).
+#if defined(__AVX2__)
+inline constexpr std::size_t digitBlockSize = 32;
+
+inline quint64 digitMask(const char *block)
+{
+    const auto bytes   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    const auto offsets = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+    // digits are the bytes whose offset from '0' is at most 9 as unsigned
+    const auto digits = _mm256_cmpeq_epi8(_mm256_min_epu8(offsets, _mm256_set1_epi8(9)), offsets);
+    return static_cast<quint32>(_mm256_movemask_epi8(digits));
+}
+#elif defined(__SSE2__)
+inline constexpr std::size_t digitBlockSize = 16;
+
+inline quint64 digitMask(const char *block)
+{
+    const auto bytes   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+    const auto offsets = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    // digits are the bytes whose offset from '0' is at most 9 as unsigned
+    const auto digits = _mm_cmpeq_epi8(_mm_min_epu8(offsets, _mm_set1_epi8(9)), offsets);
+    return static_cast<quint16>(_mm_movemask_epi8(digits));
+}
+#else
+inline constexpr std::size_t digitBlockSize = 0;
+
+inline quint64 digitMask(const char *)
+{
+    return 0;
+}
+#endif
+
+constexpr bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// Walks the digit runs of a text, computing each block mask only once.
+class DigitScanner
+{
+public:
+    explicit DigitScanner(std::string_view text)
+        : _text(text)
+    {}
+
+    // first position >= pos that is a digit (wantDigit) or no digit, or size
+    std::size_t find(std::size_t pos, bool wantDigit)
+    {
+        if constexpr (digitBlockSize > 0) {
+            while (pos < _text.size()) {
+                const auto block = pos - pos % digitBlockSize;
+                if (block + digitBlockSize > _text.size())
+                    break;
+                if (block != _block) {
+                    _block = block;
+                    _mask  = digitMask(_text.data() + block);
+                }
+                const auto offset = pos - block;
+                const auto bits   = (wantDigit ? _mask : ~_mask) >> offset;
+                if (const auto matches = bits & ((quint64{1} << (digitBlockSize - offset)) - 1))
+                    return pos + static_cast<std::size_t>(std::countr_zero(matches));
+                pos = block + digitBlockSize;
+            }
+        }
+
+        while (pos < _text.size() && isDigit(_text[pos]) != wantDigit)
+            ++pos;
+        return pos;
+    }
+
+private:
+    std::string_view _text;
+    std::size_t      _block = std::string_view::npos;
+    quint64          _mask  = 0;
+};
+
+} // namespace detail
+
+// Calls fn(number) for every integer in text, in order. Every byte that is not
+// a digit separates numbers and a '-' directly in front of the digits makes a
+// number negative. Nothing is allocated; fn returns false to stop early.
+template<std::integral T, typename Fn>
+void forEachNumber(std::string_view text, Fn &&fn)
+{
+    detail::DigitScanner scanner(text);
+    for (auto pos = scanner.find(0, true); pos < text.size(); pos = scanner.find(pos, true)) {
+        const bool negative = std::is_signed_v<T> && pos > 0 && text[pos - 1] == '-';
+        const auto end      = scanner.find(pos, false);
+
+        quint64 value = 0;
+        for (; pos < end; ++pos)
+            value = value * 10 + static_cast<quint64>(text[pos] - '0');
+
+        const auto number = static_cast<T>(negative ? 0 - value : value);
+        if constexpr (std::same_as<decltype(fn(number)), bool>) {
+            if (!fn(number))
+                return;
+        } else {
+            fn(number);
+        }
+    }
+}
+
+// Parses the integers of text into out and returns how many were written,
+// scanning stops once out is full.
+template<std::integral T, std::size_t Extent>
+std::size_t scanNumbers(std::string_view text, std::span<T, Extent> out)
+{
+    std::size_t count = 0;
+    if (out.empty())
+        return count;
+    forEachNumber<T>(text, [&](T number) {
+        out[count++] = number;
+        return count < out.size();
+    });
+    return count;
+}
+
+// Appends the integers of text to a QVector or std vector.
+template<typename Container>
+void appendNumbers(std::string_view text, Container &out)
+{
+    using T = typename Container::value_type;
+    forEachNumber<T>(text, [&out](T number) { out.push_back(number); });
+}
+
+} // namespace utils
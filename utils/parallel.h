@@ -0,0 +1,68 @@
+#pragma once
+
+#include "mappedinput.h"
+#include "taskpool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace utils {
+
+namespace detail {
+
+// Start of the first line at or after pos.
+inline std::size_t lineStartAtOrAfter(std::string_view text, std::size_t pos)
+{
+    if (pos == 0 || pos >= text.size())
+        return std::min(pos, text.size());
+    const auto newline = text.find('\n', pos - 1);
+    return newline == std::string_view::npos ? text.size() : newline + 1;
+}
+
+} // namespace detail
+
+inline constexpr std::size_t defaultLineChunkSize = 1024 * 1024;
+
+// Maps every line of text with map(line) and combines the results with reduce.
+// The text is cut into chunks of about chunkSize bytes at line boundaries and
+// the chunks are reduced with parallelFor() on pool, the calling thread takes
+// part as well. Each chunk is reduced starting from T{}, which must be the
+// identity of reduce, and the chunk results are combined in text order, so the
+// result does not depend on the scheduling. map is called concurrently.
+// Inputs of a single chunk are reduced on the calling thread only.
+template<typename T, typename Map, typename Reduce = std::plus<>>
+T parallelLinesReduce(std::string_view text, Map &&map, Reduce reduce = {},
+                      std::size_t chunkSize = defaultLineChunkSize, TaskPool &pool = TaskPool::instance())
+{
+    chunkSize             = std::max<std::size_t>(chunkSize, 1);
+    const auto chunkCount = (text.size() + chunkSize - 1) / chunkSize;
+
+    const auto reduceChunk = [&](std::size_t chunk) {
+        const auto begin = detail::lineStartAtOrAfter(text, chunk * chunkSize);
+        const auto end   = detail::lineStartAtOrAfter(text, (chunk + 1) * chunkSize);
+        T          result{};
+        for (const auto line : Lines(text.substr(begin, end - begin)))
+            result = reduce(std::move(result), map(line));
+        return result;
+    };
+
+    if (chunkCount <= 1)
+        return chunkCount == 0 ? T{} : reduceChunk(0);
+
+    std::vector<T> results(chunkCount);
+    const auto     reduceChunks = [&](std::size_t first, std::size_t last) {
+        for (auto chunk = first; chunk < last; ++chunk)
+            results[chunk] = reduceChunk(chunk);
+    };
+    parallelFor(0, chunkCount, 1, reduceChunks, pool);
+
+    T result{};
+    for (auto &chunkResult : results)
+        result = reduce(std::move(result), std::move(chunkResult));
+    return result;
+}
+
+} // namespace utils
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "allocstats.h"
+
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <utility>
+
+namespace utils {
+
+// Phase timings are only recorded when built with -DAOC_PROBES=ON, otherwise
+// PhaseProbe is empty and every call compiles to nothing.
+#ifdef AOC_PROBES
+inline constexpr bool probesEnabled = true;
+#else
+inline constexpr bool probesEnabled = false;
+#endif
+
+struct ProbeSample
+{
+    const char     *phase = nullptr;
+    qint64          ns    = 0;
+    AllocationStats allocations; // only counted with AOC_ALLOC_STATS
+};
+
+namespace detail {
+inline thread_local QVector<ProbeSample> probeSamples;
+} // namespace detail
+
+// Returns the samples recorded on the calling thread since the last call.
+inline QVector<ProbeSample> takeProbeSamples()
+{
+    return std::exchange(detail::probeSamples, {});
+}
+
+// Times consecutive phases of a function: a phase ends when next() starts
+// the following one or when the probe goes out of scope.
+#ifdef AOC_PROBES
+class PhaseProbe
+{
+public:
+    explicit PhaseProbe(const char *phase) { start(phase); }
+    ~PhaseProbe() { stop(); }
+    Q_DISABLE_COPY_MOVE(PhaseProbe)
+
+    void next(const char *phase)
+    {
+        stop();
+        start(phase);
+    }
+
+private:
+    void start(const char *phase)
+    {
+        _phase = phase;
+        if constexpr (allocStatsEnabled)
+            _allocations = allocationStats();
+        _timer.start();
+    }
+
+    void stop()
+    {
+        if (!_phase)
+            return;
+        const auto ns = _timer.nsecsElapsed();
+        if constexpr (allocStatsEnabled)
+            detail::probeSamples.append({_phase, ns, allocationStats() - _allocations});
+        else
+            detail::probeSamples.append({_phase, ns});
+        _phase = nullptr;
+    }
+
+    const char     *_phase = nullptr;
+    QElapsedTimer   _timer;
+    AllocationStats _allocations;
+};
+#else
+class PhaseProbe
+{
+public:
+    explicit PhaseProbe(const char *) { }
+    Q_DISABLE_COPY_MOVE(PhaseProbe)
+
+    void next(const char *) { }
+};
+#endif
+
+} // namespace utils
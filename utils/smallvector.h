@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+
+// Vector that keeps up to N elements inside the object and only allocates
+// when it grows beyond that. For the short lists of directions and neighbors
+// that searches create at every step, which then never touch the heap.
+template<typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "a small vector needs inline capacity");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T &;
+    using const_reference = const T &;
+    using iterator        = T *;
+    using const_iterator  = const T *;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values)
+    {
+        reserve(values.size());
+        for (const auto &value : values)
+            std::construct_at(_data + _size++, value);
+    }
+
+    SmallVector(const SmallVector &other)
+    {
+        reserve(other._size);
+        for (const auto &value : other)
+            std::construct_at(_data + _size++, value);
+    }
+
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) { take(other); }
+
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other) {
+            clear();
+            reserve(other._size);
+            for (const auto &value : other)
+                std::construct_at(_data + _size++, value);
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            clear();
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        release();
+    }
+
+    [[nodiscard]] size_type size() const { return _size; }
+
+    [[nodiscard]] bool empty() const { return _size == 0; }
+
+    [[nodiscard]] size_type capacity() const { return _capacity; }
+
+    // whether the elements are stored inside the object
+    [[nodiscard]] bool isInline() const { return _data == inlineData(); }
+
+    [[nodiscard]] T *data() { return _data; }
+
+    [[nodiscard]] const T *data() const { return _data; }
+
+    iterator begin() { return _data; }
+
+    iterator end() { return _data + _size; }
+
+    [[nodiscard]] const_iterator begin() const { return _data; }
+
+    [[nodiscard]] const_iterator end() const { return _data + _size; }
+
+    T &operator[](size_type index) { return _data[index]; }
+
+    const T &operator[](size_type index) const { return _data[index]; }
+
+    T &front() { return _data[0]; }
+
+    [[nodiscard]] const T &front() const { return _data[0]; }
+
+    T &back() { return _data[_size - 1]; }
+
+    [[nodiscard]] const T &back() const { return _data[_size - 1]; }
+
+    [[nodiscard]] bool contains(const T &value) const { return std::find(begin(), end(), value) != end(); }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T &emplace_back(Args &&...args)
+    {
+        if (_size < _capacity)
+            return *std::construct_at(_data + _size++, std::forward<Args>(args)...);
+
+        // the new element first, args may refer to an element that is moved
+        const auto capacity = 2 * _capacity;
+        T         *data     = std::allocator<T>().allocate(capacity);
+        std::construct_at(data + _size, std::forward<Args>(args)...);
+        relocate(data, capacity);
+        return _data[_size++];
+    }
+
+    void pop_back() { std::destroy_at(_data + --_size); }
+
+    void clear()
+    {
+        std::destroy(begin(), end());
+        _size = 0;
+    }
+
+    void reserve(size_type capacity)
+    {
+        if (capacity > _capacity)
+            relocate(std::allocator<T>().allocate(capacity), capacity);
+    }
+
+private:
+    T *inlineData() { return std::launder(reinterpret_cast<T *>(_inline)); }
+
+    const T *inlineData() const { return std::launder(reinterpret_cast<const T *>(_inline)); }
+
+    // moves the elements to data, which has room for capacity elements
+    void relocate(T *data, size_type capacity)
+    {
+        std::uninitialized_move(begin(), end(), data);
+        std::destroy(begin(), end());
+        release();
+        _data     = data;
+        _capacity = capacity;
+    }
+
+    // frees the heap buffer, if any, and goes back to the inline one
+    void release()
+    {
+        if (!isInline())
+            std::allocator<T>().deallocate(_data, _capacity);
+        _data     = inlineData();
+        _capacity = N;
+    }
+
+    // takes the elements of other, which is left empty
+    void take(SmallVector &other)
+    {
+        if (other.isInline()) {
+            std::uninitialized_move(other.begin(), other.end(), _data);
+            _size = other._size;
+            other.clear();
+            return;
+        }
+        _data     = std::exchange(other._data, other.inlineData());
+        _size     = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, N);
+    }
+
+    alignas(T) std::byte _inline[N * sizeof(T)];
+    T        *_data     = inlineData();
+    size_type _size     = 0;
+    size_type _capacity = N;
+};
+
+} // namespace utils
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QHashFunctions>
+#include <QSaveFile>
+#include <QString>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace utils {
+
+// Binary snapshots of parsed inputs, so that repeated runs on the same input
+// skip the text parsing. A type takes part by providing
+//     template<typename Archive> void serialize(Archive &ar) { ar(a, b, c); }
+// which is used both for writing and for reading, Archive::isReading tells
+// them apart. Trivially copyable values, QString, sequence containers (QVector,
+// std vectors) and associative ones (QHash, QMap) are handled by the archives.
+
+namespace detail {
+
+template<typename T, typename Archive>
+concept Serializable = requires(T &value, Archive &ar) { value.serialize(ar); };
+
+template<typename T>
+concept KeyValueContainer = requires(T &c) {
+    typename T::key_type;
+    typename T::mapped_type;
+    c.insert(std::declval<typename T::key_type>(), std::declval<typename T::mapped_type>());
+};
+
+template<typename T>
+concept SequenceContainer = requires(T &c) {
+    typename T::value_type;
+    c.size();
+    c.data();
+    c.resize(0);
+};
+
+template<typename T>
+concept RawValue = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+} // namespace detail
+
+class SnapshotWriter
+{
+public:
+    static constexpr bool isReading = false;
+
+    template<typename... Ts>
+    void operator()(const Ts &...values)
+    {
+        (write(values), ...);
+    }
+
+    [[nodiscard]] const QByteArray &data() const { return _data; }
+
+private:
+    void writeBytes(const void *bytes, std::size_t size)
+    {
+        _data.append(static_cast<const char *>(bytes), static_cast<qsizetype>(size));
+    }
+
+    void writeSize(std::size_t size) { write(static_cast<quint64>(size)); }
+
+    template<typename T>
+    void write(const T &value)
+    {
+        if constexpr (detail::Serializable<T, SnapshotWriter>) {
+            // serialize() is shared with reading and therefore not const
+            const_cast<T &>(value).serialize(*this);
+        } else if constexpr (std::same_as<T, QString>) {
+            writeSize(static_cast<std::size_t>(value.size()));
+            writeBytes(value.constData(), static_cast<std::size_t>(value.size()) * sizeof(QChar));
+        } else if constexpr (detail::KeyValueContainer<T>) {
+            writeSize(static_cast<std::size_t>(value.size()));
+            for (auto it = value.cbegin(); it != value.cend(); ++it) {
+                write(it.key());
+                write(it.value());
+            }
+        } else if constexpr (detail::SequenceContainer<T>) {
+            using Value = typename T::value_type;
+            writeSize(static_cast<std::size_t>(value.size()));
+            if constexpr (detail::RawValue<Value> && !detail::Serializable<Value, SnapshotWriter>) {
+                writeBytes(value.data(), static_cast<std::size_t>(value.size()) * sizeof(Value));
+            } else {
+                for (const auto &element : value)
+                    write(element);
+            }
+        } else {
+            static_assert(detail::RawValue<T>, "type cannot be written to a snapshot");
+            writeBytes(&value, sizeof(T));
+        }
+    }
+
+    QByteArray _data;
+};
+
+// Reads what a SnapshotWriter wrote. Reading past the end or a size that
+// cannot be right marks the reader as failed instead of crashing.
+class SnapshotReader
+{
+public:
+    explicit SnapshotReader(std::string_view data)
+        : _data(data)
+    {}
+
+    template<typename... Ts>
+    void operator()(Ts &...values)
+    {
+        (read(values), ...);
+    }
+
+    static constexpr bool isReading = true;
+
+    // whether everything read so far was valid and the data was used up
+    [[nodiscard]] bool isValid() const { return _valid && _pos == _data.size(); }
+
+    // marks the snapshot as invalid, for serialize() functions that find the
+    // values they read inconsistent
+    void invalidate() { _valid = false; }
+
+private:
+    bool readBytes(void *bytes, std::size_t size)
+    {
+        if (!_valid || size > _data.size() - _pos) {
+            _valid = false;
+            return false;
+        }
+        if (size > 0)
+            std::memcpy(bytes, _data.data() + _pos, size);
+        _pos += size;
+        return true;
+    }
+
+    // element count, checked against the remaining bytes
+    std::size_t readSize(std::size_t minElementSize)
+    {
+        quint64 size = 0;
+        read(size);
+        if (minElementSize > 0 && size > (_data.size() - _pos) / minElementSize) {
+            _valid = false;
+            return 0;
+        }
+        return static_cast<std::size_t>(size);
+    }
+
+    template<typename T>
+    void read(T &value)
+    {
+        if constexpr (detail::Serializable<T, SnapshotReader>) {
+            value.serialize(*this);
+        } else if constexpr (std::same_as<T, QString>) {
+            const auto size = readSize(sizeof(QChar));
+            value.resize(static_cast<qsizetype>(size));
+            readBytes(value.data(), size * sizeof(QChar));
+        } else if constexpr (detail::KeyValueContainer<T>) {
+            const auto size = readSize(1);
+            value.clear();
+            for (std::size_t i = 0; i < size && _valid; ++i) {
+                typename T::key_type    key{};
+                typename T::mapped_type mapped{};
+                read(key);
+                read(mapped);
+                value.insert(key, mapped);
+            }
+        } else if constexpr (detail::SequenceContainer<T>) {
+            using Value = typename T::value_type;
+            if constexpr (detail::RawValue<Value> && !detail::Serializable<Value, SnapshotReader>) {
+                const auto size = readSize(sizeof(Value));
+                value.resize(size);
+                readBytes(value.data(), size * sizeof(Value));
+            } else {
+                const auto size = readSize(1);
+                value.resize(size);
+                for (auto &element : value)
+                    read(element);
+            }
+        } else {
+            static_assert(detail::RawValue<T>, "type cannot be read from a snapshot");
+            readBytes(&value, sizeof(T));
+        }
+    }
+
+    std::string_view _data;
+    std::size_t      _pos   = 0;
+    bool             _valid = true;
+};
+
+namespace detail {
+
+// bump when the file layout or the archives change
+inline constexpr quint32 snapshotFormatVersion = 1;
+
+struct SnapshotHeader
+{
+    std::array<char, 4> magic{'A', 'O', 'C', 'S'};
+    quint32             formatVersion = snapshotFormatVersion;
+    quint32             typeVersion   = 0;
+    quint32             qtVersion     = QT_VERSION;
+    quint64             payloadSize   = 0;
+
+    bool operator==(const SnapshotHeader &) const = default;
+};
+
+inline QString &snapshotDirectoryStorage()
+{
+    static QString directory = qEnvironmentVariable("AOC_SNAPSHOT_DIR");
+    return directory;
+}
+
+// Snapshot payloads kept in memory, oldest first. Bounded, so that a long
+// running process does not grow with every input it has seen.
+struct MemorySnapshots
+{
+    static constexpr qsizetype maxCount = 64;
+
+    std::mutex                                 mutex;
+    std::atomic<bool>                          enabled{false};
+    std::deque<std::pair<QString, QByteArray>> payloads;
+
+    std::optional<QByteArray> find(const QString &key)
+    {
+        std::lock_guard lock(mutex);
+        const auto      it = std::ranges::find(payloads, key, &std::pair<QString, QByteArray>::first);
+        if (it == payloads.end())
+            return {};
+        return it->second;
+    }
+
+    void insert(const QString &key, QByteArray payload)
+    {
+        std::lock_guard lock(mutex);
+        if (std::ranges::find(payloads, key, &std::pair<QString, QByteArray>::first) != payloads.end())
+            return;
+        if (static_cast<qsizetype>(payloads.size()) == maxCount)
+            payloads.pop_front();
+        payloads.emplace_back(key, std::move(payload));
+    }
+};
+
+inline MemorySnapshots &memorySnapshots()
+{
+    static MemorySnapshots snapshots;
+    return snapshots;
+}
+
+// Content key of an input. qHash is only stable for one Qt version, which is
+// why that is part of the header.
+inline QString snapshotKey(std::string_view input)
+{
+    const QByteArrayView bytes(input.data(), static_cast<qsizetype>(input.size()));
+    return QStringLiteral("%1%2-%3")
+        .arg(qHash(bytes, 0x5eed0001), 16, 16, QChar('0'))
+        .arg(qHash(bytes, 0x5eed0002), 16, 16, QChar('0'))
+        .arg(input.size());
+}
+
+} // namespace detail
+
+// Directory of the snapshots, caching is off while it is empty. Defaults to the
+// AOC_SNAPSHOT_DIR environment variable; set it before any day runs.
+inline QString snapshotDirectory()
+{
+    return detail::snapshotDirectoryStorage();
+}
+
+inline void setSnapshotDirectory(const QString &directory)
+{
+    detail::snapshotDirectoryStorage() = directory;
+}
+
+// Also keeps the latest snapshots in memory, for long running processes that
+// see the same inputs again; works with and without a snapshot directory.
+inline void setMemorySnapshotsEnabled(bool enabled)
+{
+    detail::memorySnapshots().enabled = enabled;
+}
+
+// Returns parse() for the input text, or the result of an earlier parse of the
+// same text from its snapshot. name identifies the parsed type and version must
+// be changed whenever its serialize() changes; both are part of the file name,
+// so that builds with different versions keep their own snapshots. Snapshots
+// are memory mapped for reading and written atomically, so concurrent runs
+// never see partial files.
+//
+// This skips the text parsing, it is not a zero-copy load: the payload is
+// deserialized into newly allocated containers every time, and the returned
+// value never refers to the mapping.
+template<typename T, typename Parse>
+T cachedParse(const char *name, quint32 version, std::string_view input, Parse &&parse)
+{
+    const auto directory = snapshotDirectory();
+    auto      &memory    = detail::memorySnapshots();
+    if (directory.isEmpty() && !memory.enabled)
+        return parse();
+
+    const auto fileName = QStringLiteral("%1-v%2-%3.snapshot")
+                              .arg(QLatin1String(name))
+                              .arg(version)
+                              .arg(detail::snapshotKey(input));
+    const auto filePath = QDir(directory).filePath(fileName);
+
+    detail::SnapshotHeader expected;
+    expected.typeVersion = version;
+
+    // the header is not kept in memory, the version is part of the name
+    if (memory.enabled) {
+        if (const auto payload = memory.find(fileName)) {
+            SnapshotReader reader({payload->constData(), static_cast<std::size_t>(payload->size())});
+            T              value{};
+            reader(value);
+            if (reader.isValid())
+                return value;
+        }
+    }
+
+    QFile file(filePath);
+    if (!directory.isEmpty() && file.open(QIODevice::ReadOnly)
+        && file.size() >= static_cast<qint64>(sizeof(expected))) {
+        if (const auto *mapped = file.map(0, file.size())) {
+            detail::SnapshotHeader header;
+            std::memcpy(&header, mapped, sizeof(header));
+            const auto payloadSize = static_cast<std::size_t>(file.size()) - sizeof(header);
+            expected.payloadSize   = payloadSize;
+            if (header == expected) {
+                const auto    *payload = reinterpret_cast<const char *>(mapped) + sizeof(header);
+                SnapshotReader reader({payload, payloadSize});
+                T              value{};
+                reader(value);
+                if (reader.isValid()) {
+                    if (memory.enabled)
+                        memory.insert(fileName, QByteArray(payload, static_cast<qsizetype>(payloadSize)));
+                    return value;
+                }
+            }
+            qWarning() << "Ignoring invalid snapshot" << filePath;
+        }
+    }
+
+    T value = parse();
+
+    SnapshotWriter writer;
+    writer(value);
+    if (memory.enabled)
+        memory.insert(fileName, writer.data());
+    if (directory.isEmpty())
+        return value;
+
+    expected.payloadSize = static_cast<quint64>(writer.data().size());
+
+    QSaveFile out(filePath);
+    if (!QDir().mkpath(directory) || !out.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write snapshot" << filePath;
+        return value;
+    }
+    out.write(reinterpret_cast<const char *>(&expected), sizeof(expected));
+    out.write(writer.data());
+    if (!out.commit())
+        qWarning() << "Failed to write snapshot" << filePath;
+    return value;
+}
+
+} // namespace utils
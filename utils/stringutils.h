@@ -0,0 +1,156 @@
+#pragma once
+
+#include <QString>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+namespace utils {
+
+inline constexpr std::string_view whitespace = " \t\n\v\f\r";
+
+constexpr std::string_view trimmed(std::string_view s)
+{
+    const auto first = s.find_first_not_of(whitespace);
+    if (first == std::string_view::npos)
+        return {};
+    return s.substr(first, s.find_last_not_of(whitespace) - first + 1);
+}
+
+// Like QString::toInt() and friends: surrounding whitespace is ignored, 0 is returned for invalid input.
+template<typename T>
+T toNumber(std::string_view s, int base = 10)
+{
+    s = trimmed(s);
+    if (s.starts_with('+'))
+        s.remove_prefix(1);
+    T value{};
+    if (std::from_chars(s.data(), s.data() + s.size(), value, base).ec != std::errc{})
+        return T{};
+    return value;
+}
+
+inline QString toQString(std::string_view s)
+{
+    return QString::fromUtf8(s.data(), static_cast<qsizetype>(s.size()));
+}
+
+class SplitIterator
+{
+public:
+    using iterator_concept  = std::forward_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type        = std::string_view;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::string_view *;
+    using reference         = std::string_view;
+
+    SplitIterator() = default;
+
+    SplitIterator(std::string_view text, char separator, Qt::SplitBehavior behavior)
+        : _rest(text)
+        , _separator(separator)
+        , _behavior(behavior)
+        , _done(false)
+        , _last(false)
+    {
+        advance();
+    }
+
+    std::string_view operator*() const { return _part; }
+
+    SplitIterator &operator++()
+    {
+        advance();
+        return *this;
+    }
+
+    SplitIterator operator++(int)
+    {
+        auto copy = *this;
+        advance();
+        return copy;
+    }
+
+    bool operator==(const SplitIterator &other) const
+    {
+        return _done == other._done && (_done || (_part.data() == other._part.data() && _last == other._last));
+    }
+
+private:
+    void advance()
+    {
+        do {
+            if (_last) {
+                _done = true;
+                _part = {};
+                return;
+            }
+
+            const auto pos = _rest.find(_separator);
+            if (pos == std::string_view::npos) {
+                _part = _rest;
+                _last = true;
+            } else {
+                _part = _rest.substr(0, pos);
+                _rest.remove_prefix(pos + 1);
+            }
+        } while (_part.empty() && _behavior.testFlag(Qt::SkipEmptyParts));
+    }
+
+    std::string_view  _rest;
+    std::string_view  _part;
+    char              _separator = ' ';
+    Qt::SplitBehavior _behavior  = Qt::KeepEmptyParts;
+    bool              _done      = true;
+    bool              _last      = true;
+};
+
+// Lazy counterpart of QString::split() handing out views into s.
+class Split : public std::ranges::view_interface<Split>
+{
+public:
+    Split() = default;
+
+    Split(std::string_view text, char separator, Qt::SplitBehavior behavior)
+        : _text(text)
+        , _separator(separator)
+        , _behavior(behavior)
+    {}
+
+    [[nodiscard]] SplitIterator begin() const { return {_text, _separator, _behavior}; }
+
+    [[nodiscard]] SplitIterator end() const { return {}; }
+
+private:
+    std::string_view  _text;
+    char              _separator = ' ';
+    Qt::SplitBehavior _behavior  = Qt::KeepEmptyParts;
+};
+
+inline Split split(std::string_view s, char separator, Qt::SplitBehavior behavior = Qt::KeepEmptyParts)
+{
+    return {s, separator, behavior};
+}
+
+// The first N parts of split(s, separator, behavior); missing parts are empty.
+template<std::size_t N>
+std::array<std::string_view, N> splitFixed(std::string_view  s,
+                                           char              separator,
+                                           Qt::SplitBehavior behavior = Qt::KeepEmptyParts)
+{
+    std::array<std::string_view, N> result{};
+    std::size_t                     i = 0;
+    for (const auto part : split(s, separator, behavior)) {
+        if (i == N)
+            break;
+        result[i++] = part;
+    }
+    return result;
+}
+
+} // namespace utils
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <QThread>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+// Work-stealing pool for task-parallel solvers. Every worker has its own deque:
+// it pushes and pops the tasks it spawns at the back, so nested forks run
+// depth first, and idle workers steal from the front of the other deques.
+// Tasks spawned by threads outside of the pool go to a shared injection deque.
+// Use it through TaskGroup, parallelInvoke() and parallelFor().
+class TaskPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit TaskPool(int threadCount = QThread::idealThreadCount())
+        : _queues(static_cast<std::size_t>(qMax(threadCount, 1)) + 1)
+    {
+        const auto workers = _queues.size() - 1;
+        _threads.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i)
+            _threads.emplace_back([this, i] { work(i); });
+    }
+
+    ~TaskPool()
+    {
+        {
+            std::lock_guard lock(_sleepMutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto &thread : _threads)
+            thread.join();
+    }
+
+    Q_DISABLE_COPY_MOVE(TaskPool)
+
+    // the pool shared by all days, one worker per core unless
+    // setInstanceThreadCount() was called before its first use
+    static TaskPool &instance()
+    {
+        static TaskPool pool(instanceThreadCount());
+        return pool;
+    }
+
+    static void setInstanceThreadCount(int threadCount) { instanceThreadCount() = threadCount; }
+
+    [[nodiscard]] int threadCount() const { return static_cast<int>(_threads.size()); }
+
+    void push(Task task)
+    {
+        // counted first, so that the count never drops below the queued tasks
+        _queued.fetch_add(1);
+        auto &queue = _queues[ownQueue()];
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            // pairs with the predicate check of a worker going to sleep
+            std::lock_guard lock(_sleepMutex);
+        }
+        _wake.notify_one();
+    }
+
+    // Runs one queued task on the calling thread, if there is any. Lets a
+    // thread that waits for its tasks help instead of blocking a worker.
+    // Workers only help with tasks spawned inside the pool: tasks pushed from
+    // outside are independent jobs, which must not nest in the one that waits.
+    bool runOne()
+    {
+        auto task = take(ownQueue(), currentPool != this);
+        if (!task)
+            return false;
+        (*task)();
+        return true;
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    // deque of the calling worker, the injection deque for other threads
+    [[nodiscard]] std::size_t ownQueue() const
+    {
+        return currentPool == this ? currentWorker : _queues.size() - 1;
+    }
+
+    static int &instanceThreadCount()
+    {
+        static int threadCount = QThread::idealThreadCount();
+        return threadCount;
+    }
+
+    std::optional<Task> take(std::size_t own, bool injected)
+    {
+        if (_queued.load() == 0)
+            return {};
+
+        // own tasks newest first, then steal the oldest task of the others
+        for (std::size_t i = 0; i < _queues.size(); ++i) {
+            const auto index = (own + i) % _queues.size();
+            if (!injected && index == _queues.size() - 1)
+                continue;
+            auto           &queue = _queues[index];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            auto task = i == 0 ? std::move(queue.tasks.back()) : std::move(queue.tasks.front());
+            if (i == 0)
+                queue.tasks.pop_back();
+            else
+                queue.tasks.pop_front();
+            _queued.fetch_sub(1);
+            return task;
+        }
+        return {};
+    }
+
+    void work(std::size_t index)
+    {
+        currentPool   = this;
+        currentWorker = index;
+        for (;;) {
+            if (auto task = take(index, true)) {
+                (*task)();
+                continue;
+            }
+            std::unique_lock lock(_sleepMutex);
+            _wake.wait(lock, [this] { return _stopping || _queued.load() > 0; });
+            if (_stopping)
+                return;
+        }
+    }
+
+    static inline thread_local const TaskPool *currentPool   = nullptr;
+    static inline thread_local std::size_t     currentWorker = 0;
+
+    std::vector<Queue>       _queues;
+    std::vector<std::thread> _threads;
+    std::atomic<std::size_t> _queued{0};
+    std::mutex               _sleepMutex;
+    std::condition_variable  _wake;
+    bool                     _stopping = false;
+};
+
+// Fork/join scope: run() spawns a task, wait() returns once all of them have
+// finished and rethrows the first exception one of them threw. The waiting
+// thread runs queued tasks meanwhile, so groups can be nested in tasks.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(TaskPool &pool = TaskPool::instance())
+        : _pool(pool)
+        , _state(std::make_shared<State>())
+    {}
+
+    ~TaskGroup() { waitForTasks(); }
+
+    Q_DISABLE_COPY_MOVE(TaskGroup)
+
+    template<typename Fn>
+    void run(Fn &&fn)
+    {
+        _state->pending.fetch_add(1);
+        _pool.push([state = _state, fn = std::forward<Fn>(fn)]() mutable {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard lock(state->mutex);
+                if (!state->exception)
+                    state->exception = std::current_exception();
+            }
+            state->pending.fetch_sub(1);
+        });
+    }
+
+    void wait()
+    {
+        waitForTasks();
+        if (auto exception = std::exchange(_state->exception, {}))
+            std::rethrow_exception(exception);
+    }
+
+private:
+    struct State
+    {
+        std::atomic<int>   pending{0};
+        std::mutex         mutex;
+        std::exception_ptr exception;
+    };
+
+    void waitForTasks()
+    {
+        while (_state->pending.load() > 0) {
+            if (!_pool.runOne())
+                std::this_thread::yield();
+        }
+    }
+
+    TaskPool              &_pool;
+    std::shared_ptr<State> _state;
+};
+
+// Runs a and b in parallel, b on the calling thread.
+template<typename A, typename B>
+void parallelInvoke(A &&a, B &&b, TaskPool &pool = TaskPool::instance())
+{
+    TaskGroup group(pool);
+    group.run(std::forward<A>(a));
+    std::forward<B>(b)();
+    group.wait();
+}
+
+// Calls body(first, last) on subranges of [begin, end) in parallel. The range
+// is split in halves until a part has at most grainSize elements, so a grain
+// should be large enough to outweigh spawning a task.
+template<typename Body>
+void parallelFor(std::size_t begin, std::size_t end, std::size_t grainSize, const Body &body,
+                 TaskPool &pool = TaskPool::instance())
+{
+    if (end <= begin)
+        return;
+    if (end - begin <= std::max<std::size_t>(grainSize, 1)) {
+        body(begin, end);
+        return;
+    }
+
+    const auto middle = begin + (end - begin) / 2;
+    parallelInvoke([&] { parallelFor(middle, end, grainSize, body, pool); },
+                   [&] { parallelFor(begin, middle, grainSize, body, pool); }, pool);
+}
+
+} // namespace utils
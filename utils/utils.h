@@ -1,75 +1,225 @@
 #pragma once
 
-#include <numeric>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
 #include <utility>
-#include <QVector>
 
 namespace utils {
 
-template<typename Iterable>
-class enumerate_object
+// Element pair that the iterators of enumerate() and zip() yield, holding the
+// references into the ranges. A type of its own, so that it can have a common
+// reference with the std::pair value type, as ranges require. std::pair only
+// has that from C++23 on, which libstdc++ 12 does not implement yet.
+template<typename First, typename Second>
+struct ReferencePair : std::pair<First, Second>
 {
-private:
-    Iterable                        _iter;
-    std::size_t                     _size;
-    decltype(std::begin(_iter))     _begin;
-    const decltype(std::end(_iter)) _end;
+    using std::pair<First, Second>::pair;
+
+    // binds references to the elements of a mutable pair, which std::pair
+    // also only does from C++23 on
+    template<typename U1, typename U2>
+        requires std::is_constructible_v<First, U1 &> && std::is_constructible_v<Second, U2 &>
+    ReferencePair(std::pair<U1, U2> &other)
+        : std::pair<First, Second>(other.first, other.second)
+    {}
+};
 
+// Lazy view of (index, element) pairs, the elements are references into the
+// underlying range. Like std::views::enumerate, which not every supported
+// standard library has yet.
+template<std::ranges::view V>
+class EnumerateView : public std::ranges::view_interface<EnumerateView<V>>
+{
 public:
-    enumerate_object(Iterable iter)
-        : _iter(iter)
-        , _size(0)
-        , _begin(std::begin(iter))
-        , _end(std::end(iter))
+    class Iterator
+    {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type       = std::pair<std::ptrdiff_t, std::ranges::range_value_t<V>>;
+        using reference        = ReferencePair<std::ptrdiff_t, std::ranges::range_reference_t<V>>;
+        using difference_type  = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(std::ranges::iterator_t<V> current, std::ptrdiff_t index)
+            : _current(std::move(current))
+            , _index(index)
+        {}
+
+        reference operator*() const { return {_index, *_current}; }
+
+        Iterator &operator++()
+        {
+            ++_current;
+            ++_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const Iterator &other) const { return _current == other._current; }
+
+        friend bool operator==(const Iterator &it, const std::ranges::sentinel_t<V> &end) { return it._current == end; }
+
+    private:
+        std::ranges::iterator_t<V> _current{};
+        std::ptrdiff_t             _index = 0;
+    };
+
+    EnumerateView() = default;
+
+    explicit EnumerateView(V base)
+        : _base(std::move(base))
     {}
 
-    const enumerate_object &begin() const { return *this; }
+    Iterator begin() { return {std::ranges::begin(_base), 0}; }
 
-    const enumerate_object &end() const { return *this; }
+    auto end() { return std::ranges::end(_base); }
 
-    bool operator!=(const enumerate_object &) const { return _begin != _end; }
+private:
+    V _base;
+};
 
-    void operator++()
+// Lazy view of the pairs of elements at the same position in both ranges, it
+// ends with the shorter one. Like std::views::zip restricted to two ranges.
+template<std::ranges::view V1, std::ranges::view V2>
+class ZipView : public std::ranges::view_interface<ZipView<V1, V2>>
+{
+public:
+    class Sentinel;
+
+    class Iterator
     {
-        ++_begin;
-        ++_size;
-    }
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using value_type       = std::pair<std::ranges::range_value_t<V1>, std::ranges::range_value_t<V2>>;
+        using reference        = ReferencePair<std::ranges::range_reference_t<V1>, std::ranges::range_reference_t<V2>>;
+        using difference_type  = std::ptrdiff_t;
+
+        Iterator() = default;
+
+        Iterator(std::ranges::iterator_t<V1> first, std::ranges::iterator_t<V2> second)
+            : _first(std::move(first))
+            , _second(std::move(second))
+        {}
+
+        reference operator*() const { return {*_first, *_second}; }
+
+        Iterator &operator++()
+        {
+            ++_first;
+            ++_second;
+            return *this;
+        }
 
-    auto operator*() const -> std::pair<std::size_t, decltype(*_begin)> { return {_size, *_begin}; }
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(const Iterator &other) const { return _first == other._first || _second == other._second; }
+
+    private:
+        friend class Sentinel;
+
+        std::ranges::iterator_t<V1> _first{};
+        std::ranges::iterator_t<V2> _second{};
+    };
+
+    class Sentinel
+    {
+    public:
+        Sentinel() = default;
+
+        Sentinel(std::ranges::sentinel_t<V1> first, std::ranges::sentinel_t<V2> second)
+            : _first(std::move(first))
+            , _second(std::move(second))
+        {}
+
+        friend bool operator==(const Iterator &it, const Sentinel &end) { return end.isReachedBy(it); }
+
+    private:
+        [[nodiscard]] bool isReachedBy(const Iterator &it) const
+        {
+            return it._first == _first || it._second == _second;
+        }
+
+        std::ranges::sentinel_t<V1> _first{};
+        std::ranges::sentinel_t<V2> _second{};
+    };
+
+    ZipView() = default;
+
+    ZipView(V1 first, V2 second)
+        : _first(std::move(first))
+        , _second(std::move(second))
+    {}
+
+    Iterator begin() { return {std::ranges::begin(_first), std::ranges::begin(_second)}; }
+
+    Sentinel end() { return {std::ranges::end(_first), std::ranges::end(_second)}; }
+
+private:
+    V1 _first;
+    V2 _second;
 };
 
-template<typename Iterable>
-auto enumerate(Iterable &&iter) -> enumerate_object<Iterable>
+template<std::ranges::viewable_range R>
+auto enumerate(R &&range)
 {
-    return {std::forward<Iterable>(iter)};
+    return EnumerateView(std::views::all(std::forward<R>(range)));
 }
 
-template<typename Iterable>
-auto sum(Iterable &&iter)
+template<std::ranges::viewable_range R1, std::ranges::viewable_range R2>
+auto zip(R1 &&first, R2 &&second)
 {
-    using T = typename std::remove_reference<decltype(*std::begin(iter))>::type;
-    return std::accumulate(std::begin(iter), std::end(iter), T{});
+    return ZipView(std::views::all(std::forward<R1>(first)), std::views::all(std::forward<R2>(second)));
 }
 
-template<typename T, typename U>
-QVector<std::pair<T, U>> zip(const QVector<T> &v1, const QVector<U> &v2)
+// Sum of the elements, also of containers like QMap whose iterators yield the values.
+template<typename Range>
+auto sum(Range &&range)
 {
-    QVector<std::pair<T, U>> result;
-    auto                     size = std::min(v1.size(), v2.size());
-    result.reserve(size);
-    for (int i = 0; i < size; ++i)
-        result.append({v1[i], v2[i]});
+    std::remove_cvref_t<decltype(*std::begin(range))> result{};
+    for (auto &&value : range)
+        result += value;
     return result;
 }
 
-QVector<std::pair<QChar, QChar>> zip(const QString &v1, const QString &v2)
+} // namespace utils
+
+// The common reference of a ReferencePair and a std::pair is the pair of the
+// common references of the elements, as it is for two std::pairs in C++23.
+// It is a ReferencePair, which both convert to.
+template<typename T1, typename T2, typename U1, typename U2, template<typename> class TQual,
+         template<typename> class UQual>
+    requires requires {
+        typename utils::ReferencePair<std::common_reference_t<TQual<T1>, UQual<U1>>,
+                                      std::common_reference_t<TQual<T2>, UQual<U2>>>;
+    }
+struct std::basic_common_reference<utils::ReferencePair<T1, T2>, std::pair<U1, U2>, TQual, UQual>
 {
-    QVector<std::pair<QChar, QChar>> result;
-    auto                             size = std::min(v1.size(), v2.size());
-    result.reserve(size);
-    for (int i = 0; i < size; ++i)
-        result.append({v1[i], v2[i]});
-    return result;
-}
+    using type = utils::ReferencePair<std::common_reference_t<TQual<T1>, UQual<U1>>,
+                                      std::common_reference_t<TQual<T2>, UQual<U2>>>;
+};
 
-} // namespace utils
+template<typename T1, typename T2, typename U1, typename U2, template<typename> class TQual,
+         template<typename> class UQual>
+    requires requires {
+        typename utils::ReferencePair<std::common_reference_t<TQual<T1>, UQual<U1>>,
+                                      std::common_reference_t<TQual<T2>, UQual<U2>>>;
+    }
+struct std::basic_common_reference<std::pair<T1, T2>, utils::ReferencePair<U1, U2>, TQual, UQual>
+{
+    using type = utils::ReferencePair<std::common_reference_t<TQual<T1>, UQual<U1>>,
+                                      std::common_reference_t<TQual<T2>, UQual<U2>>>;
+};